@@ -0,0 +1,270 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+
+import argparse
+import json
+import numpy as np
+import platform
+import sys
+from time import perf_counter, strftime
+import tracemalloc
+from typing import Any, Callable, Dict, Optional, Tuple
+
+# problem sizes per case: (quick, realistic)
+SIZES = {
+    'property_call': (10**4, 10**5),
+    'property_eval_batch': (10**5, 10**6),
+    'gasmix_k': (10**3, 10**5),
+    'poiseulle_colebrook': (10**5, 10**6),
+    'poisson_nonlin_fvm1': (10**4, 10**6),
+    'trans_heat_pipe': (100, 1000),
+    'conduction_fvm': (100, 500),
+    'grid_mapping': (10**5, 10**7),
+}
+
+
+def _property_call(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.matter.liquids import Water
+    water = Water()
+    T = np.linspace(280., 360., n)
+    return n, lambda: [water.rho(T_, 1e5) for T_ in T]
+
+
+def _property_eval_batch(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.matter.liquids import Water
+    water = Water()
+    T = np.linspace(280., 360., n)
+    return n, lambda: water.rho.eval_batch(T, 1e5)
+
+
+def _gasmix_k(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.matter.gases import (Air, Ar, CH4, CO, CO2, H2, H2O, 
+                                         He, N2, Neon, NH3, O2)
+    from whiteboxes.property.gasmix import GasMix
+    mix = GasMix('mix12')
+    for gas in (Air, Ar, CH4, CO, CO2, H2, H2O, He, N2, Neon, NH3, O2):
+        mix.add(gas, 1. / 12)
+    T = np.linspace(400., 1200., n)
+    return n, lambda: mix.k.eval_batch(T, 1e5)
+
+
+def _poiseulle_colebrook(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.flow.pressure_drop import poiseulle_colebrook
+    Re = np.logspace(3, 8, n)
+    return n, lambda: poiseulle_colebrook(Re, 0.05, 1e-5)
+
+
+def _poisson_nonlin_fvm1(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.heat.poisson_fvm1_nonlin import \
+        poisson_bc1_bc1_nonlin_fvm1
+    return n, lambda: poisson_bc1_bc1_nonlin_fvm1(n_vol=n, 
+        k_coeff=(1., 0.05, 1e-3), T_west=0., T_east=100., method='newton',
+        mse=1e-10)
+
+
+def _trans_heat_pipe(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.heat.example_heat_pipe1d import TransHeat1DPipe
+    pipe = TransHeat1DPipe()
+    # throughput counts cells times time steps, see 'steps' of run()
+    pipe.run(nx=10, scheme='implicit')
+    steps = pipe.run(nx=n, scheme='implicit')['steps']
+    return n * steps, lambda: pipe.run(nx=n, scheme='implicit')
+
+
+def _conduction_fvm(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.heat.conduction_fvm import conduction_fvm
+    from whiteboxes.mesh.face import Face
+    from whiteboxes.mesh.partly_regular import PartlyRegularMesh
+    mesh = PartlyRegularMesh((n+1, n+1), (0., 1.), (0., 1.), 
+                             dtype=np.float64)
+    bc = {Face.WEST: ('dirichlet', 400.), 
+          Face.EAST: ('convective', 20., 300.)}
+    return n * n, lambda: conduction_fvm(mesh, lambda T: 
+                                         15. + 0.01 * (T - 300.), bc)
+
+
+def _grid_mapping(n: int) -> Tuple[int, Callable[[], Any]]:
+    from whiteboxes.mesh.grid_mapping import irregular_grid_mapping
+    rng = np.random.default_rng(0)
+    X, Y = rng.random(10**5), rng.random(10**5)
+    U = np.sin(6 * X) * np.cos(6 * Y)
+    x, y = rng.random(n), rng.random(n)
+    return n, lambda: irregular_grid_mapping(X, Y, None, U, x, y, None, 
+                                             chunk_size=10**6)
+
+
+CASES: Dict[str, Callable[[int], Tuple[int, Callable[[], Any]]]] = {
+    'property_call': _property_call,
+    'property_eval_batch': _property_eval_batch,
+    'gasmix_k': _gasmix_k,
+    'poiseulle_colebrook': _poiseulle_colebrook,
+    'poisson_nonlin_fvm1': _poisson_nonlin_fvm1,
+    'trans_heat_pipe': _trans_heat_pipe,
+    'conduction_fvm': _conduction_fvm,
+    'grid_mapping': _grid_mapping,
+}
+
+
+def run_case(key: str, quick: bool = False, 
+             repeat: int = 3) -> Dict[str, Any]:
+    """
+    Runs single benchmark case
+
+    Args:
+        key:
+            case identifier, see CASES
+
+        quick:
+            if True, then small problem sizes are used
+
+        repeat:
+            number of timed repetitions, minimum time is reported
+
+    Returns:
+        dictionary with problem size 'size', number of processed items 
+        'n_items', wall time 'time' [s], throughput 'throughput' [1/s] 
+        and peak of traced memory 'mem_peak' [byte] 
+        OR 
+        with key 'skipped' if case cannot be set up, e.g. CoolProp is 
+        missing
+    """
+    size = SIZES[key][0 if quick else 1]
+    try:
+        n_items, func = CASES[key](size)
+    except Exception as e:
+        return {'size': size, 'skipped': type(e).__name__ + ': ' + str(e)}
+
+    # first call includes JIT compilation and table builds, not timed
+    func()
+    best = np.inf
+    for _ in range(repeat):
+        start = perf_counter()
+        func()
+        best = min(best, perf_counter() - start)
+
+    # memory is traced in a separate run, tracing slows execution
+    tracemalloc.start()
+    func()
+    mem_peak = tracemalloc.get_traced_memory()[1]
+    tracemalloc.stop()
+
+    return {'size': size, 'n_items': n_items, 'time': best, 
+            'throughput': n_items / best, 'mem_peak': mem_peak}
+
+
+def run_suite(keys: Optional[list] = None, quick: bool = False,
+              repeat: int = 3, silent: bool = False) -> Dict[str, Any]:
+    """
+    Runs benchmark cases
+
+    Returns:
+        dictionary with 'meta' (environment) and 'cases' (results of 
+        run_case() per case)
+    """
+    results = {'meta': {'date': strftime('%Y-%m-%d %H:%M:%S'),
+                        'python': sys.version.split()[0],
+                        'numpy': np.__version__,
+                        'platform': platform.platform(),
+                        'quick': quick},
+               'cases': {}}
+    for key in keys or CASES:
+        res = run_case(key, quick, repeat)
+        results['cases'][key] = res
+        if not silent:
+            if 'skipped' in res:
+                print('{:>22}  skipped: {}'.format(key, res['skipped']))
+            else:
+                print('{:>22}  {:>10}  {:>10.3f}s  {:>12.3e}/s  {:>8.1f}MB'
+                      .format(key, res['size'], res['time'], 
+                              res['throughput'], res['mem_peak'] / 2**20))
+    return results
+
+
+def compare(results: Dict[str, Any], baseline: Dict[str, Any],
+            tolerance: float = 0.2, silent: bool = False
+            ) -> Dict[str, Dict[str, float]]:
+    """
+    Compares results with baseline of an earlier release
+
+    Args:
+        results:
+            results of run_suite()
+
+        baseline:
+            results of run_suite(), e.g. loaded from JSON file
+
+        tolerance:
+            relative loss of throughput or relative increase of memory 
+            beyond which a case is a regression
+
+    Returns:
+        regressions: {case: {'speed': current/baseline throughput, 
+                             'memory': current/baseline memory}}
+    """
+    regressions = {}
+    for key, res in results['cases'].items():
+        ref = baseline.get('cases', {}).get(key)
+        if ref is None or 'skipped' in res or 'skipped' in ref or \
+                res['size'] != ref['size']:
+            continue
+        speed = res['throughput'] / ref['throughput']
+        memory = res['mem_peak'] / max(ref['mem_peak'], 1)
+        regressed = speed < 1. - tolerance or memory > 1. + tolerance
+        if regressed:
+            regressions[key] = {'speed': speed, 'memory': memory}
+        if not silent:
+            print('{:>22}  speed: {:>6.2f}x  memory: {:>6.2f}x  {}'.format(
+                key, speed, memory, '!!! regression' if regressed else ''))
+    return regressions
+
+
+def main(argv: Optional[list] = None) -> int:
+    parser = argparse.ArgumentParser(description='whiteboxes benchmarks')
+    parser.add_argument('cases', nargs='*', 
+                        help='cases to run, default: all of ' + 
+                        ', '.join(CASES))
+    parser.add_argument('--quick', action='store_true',
+                        help='small problem sizes')
+    parser.add_argument('--repeat', type=int, default=3)
+    parser.add_argument('--save', help='write results to JSON file')
+    parser.add_argument('--compare', help='baseline JSON file')
+    parser.add_argument('--tolerance', type=float, default=0.2)
+    args = parser.parse_args(argv)
+    unknown = set(args.cases) - set(CASES)
+    if unknown:
+        parser.error('unknown cases: ' + ', '.join(sorted(unknown)))
+
+    results = run_suite(args.cases or None, args.quick, args.repeat)
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump(results, f, indent=1)
+    if args.compare:
+        with open(args.compare) as f:
+            baseline = json.load(f)
+        if compare(results, baseline, args.tolerance):
+            return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
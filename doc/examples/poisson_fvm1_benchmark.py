@@ -0,0 +1,110 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+from time import perf_counter
+import numpy as np
+from typing import Dict, Iterable
+
+from whiteboxes.heat.poisson_fvm1_nonlin import poisson_bc1_bc1_fvm1
+
+
+def poisson_fvm1_benchmark(n_vols: Iterable[int] = (1000, 10000, 100000,
+                                                    1000000),
+                           n_vol_max_loop: int = 100000,
+                           k_coeff: Iterable[float] = (1., 0.1, 1e-3),
+                           repeat: int = 3,
+                           silent: bool = False) -> Dict[str, Dict[int, float]]:
+    """
+    Compares execution time of the assembly variants of
+    poisson_bc1_bc1_fvm1(): 'loop' (scalar callables, former default),
+    'vectorized' (array callables) and 'compiled' (polynomial k_coeff)
+
+    Args:
+        n_vols:
+            sequence of number of finite volumes
+
+        n_vol_max_loop:
+            upper limit of n_vol for the slow 'loop' variant
+
+        k_coeff:
+            conductivity polynomial k0 + k1*(T-T_ref) + k2*(T-T_ref)^2
+
+        repeat:
+            number of repetitions, minimum time is reported
+
+        silent:
+            if False, then print table of results
+
+    Returns:
+        dictionary of execution times [s]: times[assembly][n_vol]
+    """
+    k_coeff = np.asfarray(k_coeff)
+    conductivity = lambda x, T: k_coeff[0] + T * (k_coeff[1] +
+                                                  T * k_coeff[2])
+    variants = {
+        'loop': dict(assembly='loop', conductivity=conductivity),
+        'vectorized': dict(assembly='vectorized', conductivity=conductivity),
+        'compiled': dict(assembly='compiled', k_coeff=k_coeff),
+    }
+
+    # triggers jit-compilation before timing
+    poisson_bc1_bc1_fvm1(n_vol=10, **variants['compiled'])
+
+    times: Dict[str, Dict[int, float]] = {key: {} for key in variants}
+    T_ref = {}
+    for n_vol in n_vols:
+        for key, kwargs in variants.items():
+            if key == 'loop' and n_vol > n_vol_max_loop:
+                continue
+            best = np.inf
+            for _ in range(repeat):
+                start = perf_counter()
+                x, T, dTdx_west, dTdx_east = poisson_bc1_bc1_fvm1(
+                    n_vol=n_vol, T_west=0., T_east=100., **kwargs)
+                best = min(best, perf_counter() - start)
+            times[key][n_vol] = best
+
+            # all variants must give identical solutions
+            if n_vol not in T_ref:
+                T_ref[n_vol] = T
+            assert np.allclose(T, T_ref[n_vol]), key
+
+    if not silent:
+        print('{:>10}'.format('n_vol') +
+              ''.join('{:>14}'.format(key) for key in variants) +
+              '{:>10}'.format('speedup'))
+        for n_vol in n_vols:
+            row = '{:>10}'.format(n_vol)
+            for key in variants:
+                t = times[key].get(n_vol)
+                row += '{:>12.2f}ms'.format(t * 1e3) if t is not None \
+                    else '{:>14}'.format('-')
+            if n_vol in times['loop']:
+                row += '{:>9.0f}x'.format(times['loop'][n_vol] /
+                                          times['compiled'][n_vol])
+            print(row)
+
+    return times
+
+
+if __name__ == '__main__':
+    poisson_fvm1_benchmark()
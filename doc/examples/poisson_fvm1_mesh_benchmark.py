@@ -0,0 +1,92 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+
+import numpy as np
+from typing import Dict, Iterable
+
+from whiteboxes.heat.poisson_fvm1_nonlin import poisson_bc1_bc1_nonlin_fvm1
+from whiteboxes.mesh.distribution import Distribution
+from whiteboxes.mesh.partly_regular import PartlyRegularMesh
+
+
+def poisson_fvm1_mesh_benchmark(n_vols: Iterable[int] = (10, 20, 40, 80, 160,
+                                                         320, 640),
+                                m: float = 100.,
+                                beta: float = 3.,
+                                silent: bool = False
+                                ) -> Dict[str, Dict[int, float]]:
+    """
+    Compares accuracy of poisson_bc1_bc1_nonlin_fvm1() on uniform and 
+    graded meshes for a boundary layer at the east boundary
+
+        d^2T/dx^2 = m^2 T,  T(0) = 0, T(1) = 1
+        exact: T = sinh(m x) / sinh(m),  dq/dt(x=1) = m coth(m)
+
+    Args:
+        n_vols:
+            sequence of number of finite volumes
+
+        m:
+            inverse thickness of boundary layer [1/m]
+
+        beta:
+            stretching factor of the externally generated tanh-mesh
+
+        silent:
+            if False, then print table of results
+
+    Returns:
+        dictionary of relative errors of heat flux density at east 
+        boundary: errors[mesh][n_vol]
+    """
+    dqdt_exact = m / np.tanh(m)
+    meshes = {
+        'uniform': lambda n: None,
+        'log+': lambda n: PartlyRegularMesh((n+1,), (0., 1.), spacing='log+',
+                                            dtype=np.float64),
+        'LOG_PLUS': lambda n: Distribution.LOG_PLUS,
+        'tanh': lambda n: np.tanh(beta * np.linspace(0., 1., n+1)) / \
+            np.tanh(beta),
+    }
+
+    errors: Dict[str, Dict[int, float]] = {key: {} for key in meshes}
+    for n_vol in n_vols:
+        for key, mesh in meshes.items():
+            res = poisson_bc1_bc1_nonlin_fvm1(n_vol=n_vol, mesh=mesh(n_vol),
+                T_west=0., T_east=1., k_coeff=(1.,), s_coeff=(0., -m**2),
+                method='newton', mse=1e-14)
+            errors[key][n_vol] = abs(res['dqdt_east'] / dqdt_exact - 1.)
+
+    if not silent:
+        print('relative error of dq/dt at east boundary, m:', m)
+        print('{:>10}'.format('n_vol') +
+              ''.join('{:>12}'.format(key) for key in meshes))
+        for n_vol in n_vols:
+            print('{:>10}'.format(n_vol) + ''.join('{:>12.2e}'.format(
+                errors[key][n_vol]) for key in meshes))
+
+    return errors
+
+
+if __name__ == '__main__':
+    poisson_fvm1_mesh_benchmark()
@@ -0,0 +1,94 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.heat.conduction_fvm import conduction_fvm
+from whiteboxes.heat.poisson_fvm1_nonlin import poisson_bc1_bc1_nonlin_fvm1
+from whiteboxes.mesh.face import Face
+from whiteboxes.mesh.partly_regular import PartlyRegularMesh
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        # constant conductivity, adiabatic north and south: linear profile
+        mesh = PartlyRegularMesh((21, 6), (0., 2.), (0., 0.5), 
+                                 dtype=np.float64)
+        res = conduction_fvm(mesh, 10., bc={Face.WEST: ('dirichlet', 300.),
+                                            Face.EAST: ('dirichlet', 400.)})
+        x = res['x'][0]
+        print('it:', res['it'], 'Q:', res['Q'])
+
+        self.assertEqual(res['T'].shape, mesh.shape)
+        self.assertEqual(res['it'], 0)
+        self.assertTrue(np.allclose(res['T'][:, 1:-1], 
+                                    300. + 50. * x[:, np.newaxis]))
+        self.assertAlmostEqual(res['Q'][Face.WEST], -10. * 50. * 0.5)
+        self.assertAlmostEqual(res['Q'][Face.EAST], 10. * 50. * 0.5)
+
+    def test2(self):
+        # temperature-dependent conductivity, graded mesh: same as 1D
+        k_coeff = (1., 0.05, 1e-3)
+        mesh = PartlyRegularMesh((41, 4), (0., 1.), (0., 1.), 
+                                 spacing=('log+', 'lin'), dtype=np.float64)
+        res = conduction_fvm(mesh, lambda T: k_coeff[0] + 
+                             T * (k_coeff[1] + T * k_coeff[2]), 
+                             bc={Face.WEST: ('dirichlet', 0.),
+                                 Face.EAST: ('dirichlet', 100.)}, mse=1e-16)
+        ref = poisson_bc1_bc1_nonlin_fvm1(mesh=mesh.X1d[0][:-1], 
+            T_west=0., T_east=100., k_coeff=k_coeff, mse=1e-16, max_it=100)
+        print('it:', res['it'], 'T:', res['T'][20, 1], ref['T'][20])
+
+        for j in range(1, mesh.shape[1] - 1):
+            self.assertTrue(np.allclose(res['T'][:, j], ref['T'], 
+                                        atol=1e-5))
+
+    def test3(self):
+        # 3D block with source, convection and heat flux: energy balance
+        mesh = PartlyRegularMesh((9, 7, 5), (0., 0.4), (0., 0.3), 
+                                 (0., 0.2), dtype=np.float64)
+        bc = {Face.WEST: ('dirichlet', 350.),
+              Face.TOP: ('convective', 25., 293.),
+              Face.NORTH: ('neumann', 500.)}
+        k = lambda T: 40. + 0.02 * (T - 300.)
+        T = {}
+        for solver in ('direct', 'cg', 'ilu-cg'):
+            res = conduction_fvm(mesh, k, bc, source=1e4, solver=solver, 
+                                 mse=1e-14)
+            T[solver] = res['T']
+            balance = sum(res['Q'].values()) + 1e4 * mesh.total_volume
+            print(solver, ': it:', res['it'], 'balance:', balance)
+
+            self.assertAlmostEqual(balance / 1e4 / mesh.total_volume, 0.,
+                                   places=6)
+        self.assertTrue(np.allclose(T['direct'], T['cg'], atol=1e-5))
+        self.assertTrue(np.allclose(T['direct'], T['ilu-cg'], atol=1e-5))
+
+
+if __name__ == '__main__':
+    unittest.main()
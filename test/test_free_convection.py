@@ -19,11 +19,13 @@
   Version:
       2019-09-27 DWW
 """
+import numpy as np
 import unittest
 
-from whiteboxes.heat.free_convection import FreeConvectionPlate
+from whiteboxes.heat.free_convection import (FreeConvectionPlate, CONV_OK,
+    CONV_INVALID_ANGLE, CONV_NOT_HEATED)
+from whiteboxes.matter.conversion import C2K
 from whiteboxes.matter.gases import Air
-from whiteboxes.matter.generic import C2K
 
 
 class TestUM(unittest.TestCase):
@@ -60,6 +62,30 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+    def test2(self):
+        # batch of panels vs. loop over scalar calls
+        foo = FreeConvectionPlate(fluid=Air(), eps_rad=0.5)
+        T_surf = C2K(np.array([40., 60., 80., 100., 30., 50., 10.]))
+        T_inf = C2K(20.)
+        L = np.array([0.1, 0.2, 0.3, 0.5, 0.1, 0.1, 0.1])
+        phi = np.array([0., 90., 45., 180., 10., 90., 90.])
+
+        alpha, status = foo.alpha_combined(T_surf, T_inf, L, phi, 
+                                           return_status=True)
+        print('alpha:', alpha, 'status:', status)
+
+        self.assertEqual(alpha.shape, T_surf.shape)
+        self.assertEqual(status[4], CONV_INVALID_ANGLE)
+        self.assertEqual(status[6], CONV_NOT_HEATED)
+        self.assertTrue(np.isnan(alpha[4]) and np.isnan(alpha[6]))
+        self.assertTrue(np.all(status[:4] == CONV_OK))
+        for i in (0, 1, 2, 3, 5):
+            alpha_i = foo.alpha_combined(float(T_surf[i]), T_inf, 
+                                         float(L[i]), float(phi[i]))
+            self.assertAlmostEqual(alpha[i], alpha_i)
+        self.assertTrue(np.isnan(foo.alpha_conv(float(T_surf[4]), T_inf, 
+                                                0.1, 10.)))
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -19,9 +19,10 @@
   Version:
       2019-11-25 DWW
 """
+import numpy as np
 import unittest
 
-import whiteboxes.property.gases as module_under_test
+import whiteboxes.matter.gases as module_under_test
 
 
 class TestUM(unittest.TestCase):
@@ -44,5 +45,62 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+    def test2(self):
+        foo = module_under_test.N2()
+        T, p = 350., 20e5
+        exact = foo.c_p(T, p)
+
+        tables = foo.tabulate(keys=('c_p',), tol=1e-5, path='')
+        approx = foo.c_p(T, p)
+        print(tables['c_p'], 'exact:', exact, 'approx:', approx)
+
+        self.assertLess(tables['c_p'].max_rel_error, 1e-5 + 1e-12)
+        self.assertAlmostEqual(approx / exact, 1., delta=1e-4)
+
+    def test3(self):
+        T, p = 400., 3e5
+        for foo in (module_under_test.N2(), module_under_test.StandardAir()):
+            state = foo.state(T, p)
+            print(foo.identifier, state)
+
+            for key in ('rho', 'c_p', 'k', 'mu'):
+                self.assertAlmostEqual(state[key] / getattr(foo, key)(T, p),
+                                       1., delta=1e-10)
+            self.assertGreater(state['c_sound'], 0.)
+
+    def test4(self):
+        foo = module_under_test.HumidAir()
+        T = np.linspace(250., 350., 11)
+        p = 1e5
+        RH = np.linspace(0.05, 0.95, 11)
+
+        W, valid = foo.RH_to_W_vec(T, p, RH)
+        self.assertTrue(valid.all())
+        RH2, valid = foo.W_to_RH_vec(T, p, W)
+        self.assertTrue(np.allclose(RH2, RH, rtol=1e-12))
+
+        # chained conversion with one evaluation of saturation pressure 
+        state = foo.psychrometrics(T, p, RH=RH, dew_point=True)
+        self.assertTrue(np.allclose(state['W'], W))
+        RH3, _ = foo.T_and_T_dew_to_RH_vec(T, state['T_dew'])
+        self.assertTrue(np.allclose(RH3, RH, rtol=1e-8))
+
+        # close to CoolProp-based scalar methods
+        for i in range(T.size):
+            W_cp = foo.RH_to_W(T[i], p, RH[i])
+            y_cp = foo.RH_to_y(T[i], p, RH[i])
+            print('T:', T[i], 'W:', W[i], W_cp, 'y:', state['y'][i], y_cp)
+            self.assertAlmostEqual(W[i] / W_cp, 1., delta=1e-2)
+            self.assertAlmostEqual(state['y'][i] / y_cp, 1., delta=1e-2)
+
+        # invalid elements are masked
+        W, valid = foo.RH_to_W_vec(np.array([300., 300., 100.]), p, 
+                                   np.array([0.5, 1.5, 0.5]))
+        self.assertTrue(np.array_equal(valid, [True, False, False]))
+        self.assertTrue(np.isnan(W[1:]).all())
+
+        RH2, valid = foo.RH1_to_RH2_vec(RH, T, T + 10.)
+        self.assertTrue(np.all(RH2[valid] < RH[valid]))
+
 if __name__ == '__main__':
     unittest.main()
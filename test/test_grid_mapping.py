@@ -0,0 +1,128 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import os
+from tempfile import gettempdir
+import unittest
+
+from whiteboxes.mesh.grid_mapping import (GridMapper, irregular_grid_mapping,
+    irregular_grid_mapping_single_unknown)
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.X, self.Y = rng.random(500), rng.random(500)
+        self.X[:4], self.Y[:4] = [0., 1., 0., 1.], [0., 0., 1., 1.]
+        self.x, self.y = rng.uniform(0.05, 0.95, (2, 200))
+        self.x[0], self.y[0] = 2., 2.                      # outside of hull
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        # linear fields are reproduced exactly by linear interpolation
+        U = np.column_stack((1. + 2. * self.X + 3. * self.Y, 
+                             self.X - self.Y))
+        mapper = GridMapper(self.X, self.Y, None, self.x, self.y, None)
+        u = mapper(U, fill_value=np.nan)
+
+        self.assertEqual(u.shape, (200, 2))
+        self.assertTrue(mapper.outside[0] and not mapper.outside[1:].any())
+        self.assertTrue(np.isnan(u[0]).all())
+        self.assertTrue(np.allclose(u[1:, 0], 
+                                    1. + 2. * self.x[1:] + 3. * self.y[1:]))
+        self.assertTrue(np.allclose(u[1:, 1], self.x[1:] - self.y[1:]))
+
+        # identical to mapping of single unknowns
+        for j in range(U.shape[1]):
+            u_single = irregular_grid_mapping_single_unknown(self.X, self.Y, 
+                None, U[:, j], self.x, self.y, None)
+            self.assertTrue(np.allclose(u_single[1:], u[1:, j]))
+            self.assertTrue(np.allclose(irregular_grid_mapping(self.X, 
+                self.Y, None, U[:, j], self.x, self.y, None), 
+                mapper(U[:, j])))
+
+    def test2(self):
+        # persisted weights are reused
+        file = os.path.join(gettempdir(), 'test_grid_mapping.npz')
+        if os.path.isfile(file):
+            os.remove(file)
+        mapper = GridMapper(self.X, self.Y, None, self.x, self.y, None, 
+                            file=file)
+        self.assertTrue(os.path.isfile(file))
+
+        mapper2 = GridMapper(self.X, self.Y, None, self.x, self.y, None, 
+                             file=file)
+        self.assertIsNone(mapper2._triangulation)       # not triangulated
+        U = np.sin(self.X) * self.Y
+        self.assertTrue(np.allclose(mapper(U), mapper2(U)))
+
+        # other target grid invalidates file
+        mapper3 = GridMapper(self.X, self.Y, None, self.y, self.x, None, 
+                             file=file)
+        self.assertIsNotNone(mapper3._triangulation)
+        os.remove(file)
+
+    def test3(self):
+        # nearest neighbor in 3D
+        Z = np.linspace(0., 1., self.X.size)
+        mapper = GridMapper(self.X, self.Y, Z, self.X[10:20], 
+                            self.Y[10:20], Z[10:20], method='nearest')
+        U = np.arange(self.X.size, dtype=float)
+        self.assertTrue(np.allclose(mapper(U), U[10:20]))
+
+    def test4(self):
+        # chunked parallel mapping of memory-mapped files vs. single block
+        Z = np.random.default_rng(2).random(self.X.size)
+        z = np.full(self.x.size, 0.5)
+        U = np.column_stack((self.X + Z, self.Y * Z))
+        files = [os.path.join(gettempdir(), 'test_grid_mapping_' + key + 
+                              '.npy') for key in ('points', 'targets', 'U')]
+        np.save(files[0], np.column_stack((self.X, self.Y, Z)))
+        np.save(files[1], np.column_stack((self.x, self.y, z)))
+        np.save(files[2], U)
+
+        reference = GridMapper(self.X, self.Y, Z, self.x, self.y, z)
+        mapper = GridMapper.from_points(files[0], files[1], chunk_size=32, 
+                                        n_jobs=4)
+        self.assertIsInstance(mapper.targets, np.memmap)
+        self.assertEqual(mapper.n_outside, reference.n_outside)
+        self.assertTrue(np.array_equal(mapper.outside_indices, 
+                                       np.flatnonzero(reference.outside)))
+
+        out = np.lib.format.open_memmap(os.path.join(gettempdir(), 
+            'test_grid_mapping_u.npy'), mode='w+', shape=(self.x.size, 2))
+        u = mapper(files[2], fill_value=np.nan, out=out)
+        self.assertIs(u, out)
+        self.assertTrue(np.allclose(u, reference(U, fill_value=np.nan), 
+                                    equal_nan=True))
+        self.assertTrue(np.isnan(u[mapper.outside]).all())
+
+        u, outside = irregular_grid_mapping(self.X, self.Y, Z, U[:, 0], 
+            self.x, self.y, z, chunk_size=50, n_jobs=2, return_outside=True)
+        self.assertTrue(np.array_equal(outside, reference.outside))
+        del out
+
+
+if __name__ == '__main__':
+    unittest.main()
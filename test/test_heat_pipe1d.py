@@ -0,0 +1,185 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.heat.example_heat_pipe1d import TransHeat1DPipe, \
+    run_pipe_batch, temperature_in_wall_for_actual_time_step, \
+    temperature_in_wall_for_theta_time_step
+
+
+def _pipe(**kwargs):
+    pipe = TransHeat1DPipe()
+    pipe.pre(**{'nx': 20, 'T_in': 100., 'T_out': 20., 'plot': False, 
+                'silent': True, **kwargs})
+    return pipe
+
+
+def _consistent_ghosts(pipe, T):
+    """
+    Sets ghost node temperatures satisfying the Robin conditions
+    """
+    beta_in = pipe.alpha_in * pipe.dx / pipe.lambda_wal
+    beta_out = pipe.alpha_out * pipe.dx / pipe.lambda_wal
+    T[0] = (T[1] * (1. - 0.5 * beta_in) + beta_in * pipe.T_in) / \
+        (1. + 0.5 * beta_in)
+    T[-1] = (T[-2] * (1. - 0.5 * beta_out) + beta_out * pipe.T_out) / \
+        (1. + 0.5 * beta_out)
+    return T
+
+
+def _march(pipe, theta, Fo, n_steps, T=None):
+    """
+    Returns temperature after n_steps steps of size Fo*dx^2/a, 
+    theta < 0: explicit scheme
+    """
+    T = np.copy(pipe.T if T is None else T)
+    T_old = np.empty_like(T)
+    work = [np.zeros(T.size) for _ in range(5)]
+    for _ in range(n_steps):
+        T_old[:] = T
+        if theta < 0.:
+            temperature_in_wall_for_actual_time_step(pipe.X, T, T_old, Fo,
+                pipe.alpha_in, pipe.alpha_out, pipe.T_in, pipe.T_out, 
+                pipe.lambda_wal, pipe.isCylinder)
+        else:
+            temperature_in_wall_for_theta_time_step(pipe.X, T, T_old, Fo, 
+                theta, pipe.alpha_in, pipe.alpha_out, pipe.T_in, 
+                pipe.T_out, pipe.lambda_wal, pipe.isCylinder, *work)
+    return T
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        pass
+
+
+    def tearDown(self):
+        pass
+
+
+    def test1(self):
+        # implicit schemes agree with explicit scheme for small steps
+        pipe = _pipe()
+        Fo, n_steps = 0.05, 4000
+        T_exp = _march(pipe, -1., Fo, n_steps)
+        span = pipe.T_in - pipe.T_out
+        for theta in (1., 0.5):
+            T = _march(pipe, theta, Fo, n_steps)
+            dev = np.abs(T[1:-1] - T_exp[1:-1]).max() / span
+            print('theta:', theta, 'max deviation from explicit:', dev)
+            self.assertLess(dev, 1e-2)
+
+
+    def test2(self):
+        # Crank-Nicolson converges at second order, implicit Euler at 
+        # first order
+        pipe = _pipe()
+        T0 = _consistent_ghosts(pipe, np.copy(pipe.T))
+        Fo, n_steps = 1., 16
+        for theta, lo, up in ((0.5, 3., 5.), (1., 1.6, 2.4)):
+            T_ref = _march(pipe, theta, Fo / 64, n_steps * 64, T0)
+            errors = [np.abs(_march(pipe, theta, Fo / m, n_steps * m, T0) 
+                             - T_ref)[1:-1].max() for m in (1, 2, 4)]
+            ratios = [errors[i] / errors[i+1] for i in range(2)]
+            print('theta:', theta, 'errors:', errors, 'ratios:', ratios)
+            self.assertTrue(lo < ratios[-1] < up)
+
+
+    def test3(self):
+        # steady state: heat flux through series of resistances
+        pipe = _pipe(isCylinder=False, alpha_out=50.)
+        T = _march(pipe, 1., 1e8, 5)
+        q_exp = (pipe.T_in - pipe.T_out) / (1. / pipe.alpha_in + 
+            (pipe.x_out - pipe.x_in) / pipe.lambda_wal + 1. / pipe.alpha_out)
+        T_wal_in, T_wal_out = 0.5 * (T[0] + T[1]), 0.5 * (T[-1] + T[-2])
+        q_in = pipe.alpha_in * (pipe.T_in - T_wal_in)
+        q_out = pipe.alpha_out * (T_wal_out - pipe.T_out)
+        q_wal = pipe.lambda_wal * (T_wal_in - T_wal_out) / \
+            (pipe.x_out - pipe.x_in)
+        print('q:', q_exp, q_in, q_wal, q_out)
+
+        for q in (q_in, q_wal, q_out):
+            self.assertAlmostEqual(q / q_exp, 1., places=6)
+
+
+    def test4(self):
+        # adaptive time step: too large initial step is rejected
+        t_exp = TransHeat1DPipe()(nx=20, plot=False, silent=True)
+        foo = TransHeat1DPipe()
+        for scheme in ('implicit', 'crank-nicolson'):
+            t_end = foo(nx=20, plot=False, silent=True, scheme=scheme, 
+                        dt=1., dT_step=0.1)
+            print(scheme, 't_end:', t_end, 'explicit:', t_exp, 
+                  'steps:', foo.i_t)
+            self.assertLess(foo.dt, 1.)
+            self.assertAlmostEqual(t_end / t_exp, 1., delta=0.05)
+
+
+    def test5(self):
+        # headless compiled loop reproduces interactive loop
+        for scheme in ('explicit', 'implicit', 'crank-nicolson'):
+            foo = TransHeat1DPipe()
+            t_loop = foo(nx=20, plot=False, silent=True, scheme=scheme)
+            steps = foo.i_t
+            res = TransHeat1DPipe().run(nx=20, scheme=scheme)
+            print(scheme, 't_end:', t_loop, res['t_end'], 
+                  'steps:', steps, res['steps'])
+
+            self.assertEqual(res['status'], 0)
+            if scheme == 'explicit':
+                # interactive loop returns time before last step
+                self.assertLessEqual(abs(res['t_end'] - t_loop), 2 * foo.dt)
+            else:
+                self.assertEqual(res['steps'], steps)
+                self.assertAlmostEqual(res['t_end'] / t_loop, 1., places=9)
+
+
+    def test6(self):
+        # batch run equals runs of single configurations, also with 
+        # individual limits
+        configs = [{'v': 3, 'alpha_out': 5}, {'v': 10, 'alpha_out': 10}, 
+                   {'v': 3, 'alpha_out': 5, 't_max': 0.1}, 
+                   {'v': 10, 'alpha_out': 5, 'i_t_max': 3}]
+        common = {'nx': 20, 'T_in': 100., 'T_out': 20., 
+                  'scheme': 'implicit'}
+        batch = run_pipe_batch(configs, snap_every=5, **common)
+        print('batch t_end:', batch['t_end'], 'status:', batch['status'])
+
+        self.assertEqual(list(batch['status']), [0, 0, 1, 2])
+        for k, config in enumerate(configs):
+            pipe = TransHeat1DPipe()
+            res = pipe.run(snap_every=5, **common, **config)
+            n = batch['n_snap'][k]
+
+            self.assertEqual(res['status'], batch['status'][k])
+            self.assertEqual(res['steps'], batch['steps'][k])
+            self.assertEqual(res['t_end'], batch['t_end'][k])
+            self.assertTrue(np.array_equal(res['t_snap'], 
+                                           batch['t_snap'][k, :n]))
+            self.assertTrue(np.array_equal(res['T_snap'], 
+                                           batch['T_snap'][k, :n]))
+            self.assertTrue(np.array_equal(pipe.T, batch['T'][k]))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -19,10 +19,11 @@
   Version:
       2018-09-27 DWW
 """
+import numpy as np
 import unittest
 
-import whiteboxes.property.liquids as module_under_test
-from whiteboxes.property.liquids import HydraulicOil
+import whiteboxes.matter.liquids as module_under_test
+from whiteboxes.matter.liquids import HydraulicOil, Water
 
 
 class TestUM(unittest.TestCase):
@@ -45,6 +46,37 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+    def test3(self):
+        foo = Water()
+        T, p, x = 320., 5e5, 0.
+        rho, grad = foo.rho.grad(T, p, x)
+        
+        dT, dp = 1e-4, 1e1
+        fd = [(foo.rho(T + dT, p, x) - foo.rho(T - dT, p, x)) / (2 * dT),
+              (foo.rho(T, p + dp, x) - foo.rho(T, p - dp, x)) / (2 * dp)]
+        print('rho:', rho, 'grad:', grad, 'finite differences:', fd)
+
+        self.assertAlmostEqual(rho, foo.rho(T, p, x))
+        self.assertTrue(np.allclose(grad[:2], fd, rtol=1e-5))
+        self.assertAlmostEqual(foo.drho_dT(T, p, x), grad[0])
+
+    def test4(self):
+        # fused state vs. separate property calls
+        foo = Water()
+        T = np.linspace(260., 390., 14).reshape(2, 7)
+        p = np.array([1e5, 20e5]).reshape(2, 1)
+        state = foo.state(T, p)
+
+        for key in ('rho', 'nu', 'mu', 'c_p', 'k', 'c_sound'):
+            self.assertEqual(state[key].shape, T.shape)
+            for i, j in np.ndindex(T.shape):
+                self.assertAlmostEqual(state[key][i, j] / getattr(foo, key)(
+                    T[i, j], p[i, 0]), 1., delta=1e-12)
+
+        state = foo.state(300.)
+        self.assertIsInstance(state['rho'], float)
+        self.assertAlmostEqual(state['rho'], foo.rho(300., foo.p.ref))
+
     def test2(self):
         foo = HydraulicOil()
         foo.plot()
@@ -21,8 +21,8 @@
 """
 import unittest
 
-from whiteboxes.property.matter import Fluid, Metal, Solid
-from whiteboxes.property.matter import Matter
+from whiteboxes.matter.matter import Fluid, Metal, Solid
+from whiteboxes.matter.matter import Matter
 from whiteboxes.property.parameter import Parameter
 from whiteboxes.property.property import Property
 
@@ -111,6 +111,31 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+    def test7(self):
+        # memoized properties follow changes of reference values 
+        mat = Matter(identifier='matter')
+        mat.rho.ref = 1000.
+        mat.beta.calc = 1e-4
+        mat.k.calc = 2.
+        mat.c_p.calc = 4000.
+        mat.memoize_all()
+
+        T = mat.rho.T.ref + 50.
+        rho, a = mat.rho(T), mat.a(T)
+        self.assertEqual(mat.rho(T), rho)
+        self.assertEqual(mat.a(T), a)
+
+        mat.rho.ref = 2000.
+        self.assertAlmostEqual(mat.rho(T), 2. * rho)
+        self.assertAlmostEqual(mat.a(T) / a, 0.5)
+
+        mat.beta.calc = 2e-4
+        self.assertAlmostEqual(mat.rho(T), 2000. / (1. + 50. * 2e-4))
+
+        mat.k.calc = 4.
+        self.assertAlmostEqual(mat.a(T) * 4000. * mat.rho(T) / 4., 1.)
+        self.assertGreater(mat.rho.memo_stats['hits'], 0)
+
 
 if __name__ == '__main__':
     unittest.main()
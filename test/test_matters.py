@@ -63,6 +63,20 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+    def test3(self):
+        collection = Matters()
+        print('Collection:', collection)
+
+        # no matter is created before first selection
+        self.assertEqual(len(collection._cache), 0)
+        self.assertIn('water', str(collection))
+
+        water = collection('water')
+        self.assertEqual(water.identifier, 'water')
+        self.assertEqual(len(collection._cache), 1)
+        self.assertIs(collection('Water'), water)
+        self.assertIsNone(collection('unknown_matter'))
+
 
 if __name__ == '__main__':
     unittest.main()
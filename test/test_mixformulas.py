@@ -0,0 +1,91 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.property.mixformulas import mason_coefficients, \
+    mix_mason, mix_mass, mix_mole
+
+
+def mason_reference(y, M, k, mu):
+    # scalar double loop of Mason & Saxena equation
+    c0 = 1.065
+    k_mix = 0.
+    for i in range(len(y)):
+        denom = 1.
+        for j in range(len(y)):
+            if i != j:
+                M12, mu12 = M[i] / M[j], mu[i] / mu[j]
+                a = c0 / (2. * np.sqrt(2)) / np.sqrt(1. + M12) \
+                    * (1. + np.sqrt(mu12 / M12) * M12**0.25)**2
+                denom += a * y[j] / y[i]
+        k_mix += k[i] / denom
+    return k_mix
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        # N2, O2, Ar, CO2, H2O at 300 K
+        self.y = np.array([0.70, 0.08, 0.01, 0.11, 0.10])
+        self.M = np.array([28.01, 32.00, 39.95, 44.01, 18.02])
+        self.k = np.array([25.9e-3, 26.3e-3, 17.7e-3, 16.8e-3, 18.7e-3])
+        self.mu = np.array([17.9e-6, 20.8e-6, 22.9e-6, 15.0e-6, 10.0e-6])
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        k_ref = mason_reference(self.y, self.M, self.k, self.mu)
+        k_mix = mix_mason(self.y, self.M, self.k, self.mu)
+        print('k_mix:', k_mix, 'reference:', k_ref)
+
+        self.assertIsInstance(k_mix, float)
+        self.assertAlmostEqual(k_mix, k_ref, delta=1e-12)
+
+    def test2(self):
+        # arrays of temperatures: properties of shape (n_comp, n_points)
+        scale = np.linspace(0.5, 2., 7)
+        k = self.k[:, np.newaxis] * scale
+        mu = self.mu[:, np.newaxis] * scale**0.7
+
+        coefficients = mason_coefficients(self.y, self.M)
+        k_mix = mix_mason(self.y, self.M, k, mu, coefficients=coefficients)
+        k_ref = [mason_reference(self.y, self.M, k[:, t], mu[:, t]) 
+                 for t in range(scale.size)]
+        print('k_mix:', k_mix)
+
+        self.assertEqual(k_mix.shape, scale.shape)
+        self.assertTrue(np.allclose(k_mix, k_ref, rtol=1e-12))
+
+    def test3(self):
+        c_p = self.k[:, np.newaxis] * np.linspace(1., 2., 5)
+        c_p_mass = mix_mass(self.y, self.M, c_p)
+        c_p_mole = mix_mole(self.y, self.M, c_p)
+
+        for t in range(c_p.shape[1]):
+            self.assertAlmostEqual(c_p_mass[t], 
+                                   mix_mass(self.y, self.M, c_p[:, t]))
+            self.assertAlmostEqual(c_p_mole[t], 
+                                   mix_mole(self.y, self.M, c_p[:, t]))
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,100 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import os
+from tempfile import gettempdir
+import unittest
+
+from whiteboxes.property.pack import PropertyPack
+from whiteboxes.property.property import Property
+from whiteboxes.property.tabulated import PropertyTable
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        self.file = os.path.join(gettempdir(), 'test_pack.pack')
+        self.k = Property('k', 'W/m/K', calc=lambda T, p, x=0.:
+                          1. + 1e-2 * T + 1e-5 * T**2 + 1e-9 * np.exp(T / 50))
+        self.rho = lambda T, p, x=0.: p / (287. * T)
+
+
+    def tearDown(self):
+        if os.path.isfile(self.file):
+            os.remove(self.file)
+
+
+    def test1(self):
+        pack = PropertyPack()
+        pack.add_fit('Foo.k', self.k, (300., 600.), order=4)
+        table = PropertyTable(self.rho, (250., 500.), (1e5, 5e5),
+                              identifier='test_pack_rho', degree=1,
+                              tol=1e-4, path='')
+        pack.add_table('Foo.rho', table)
+        self.assertTrue(pack.save(self.file))
+
+        loaded = PropertyPack.load(self.file)
+        print(loaded)
+        self.assertEqual(sorted(loaded.names()), ['Foo.k', 'Foo.rho'])
+        self.assertIsInstance(loaded['Foo.rho'].arrays['values'], np.memmap)
+        self.assertFalse(loaded['Foo.rho'].arrays['values'].flags.writeable)
+
+        # loaded surrogates are identical with surrogates of built pack
+        T = np.linspace(300., 480., 7)
+        for name in ('Foo.k', 'Foo.rho'):
+            self.assertTrue(np.array_equal(pack[name].evaluate(T, 2e5),
+                                           loaded[name].evaluate(T, 2e5)))
+
+        # error is bounded by stored error
+        for name, exact in (('Foo.k', self.k.calc), ('Foo.rho', self.rho)):
+            s = loaded[name]
+            y = s.evaluate(T, 2e5)
+            rel = np.abs(y - exact(T, 2e5)) / np.abs(exact(T, 2e5))
+            self.assertTrue(rel.max() <= 2 * s.max_rel_error + 1e-12)
+
+        # out of range
+        self.assertIsNone(loaded['Foo.k'](700.))
+        self.assertTrue(np.isnan(loaded['Foo.rho'].evaluate(300., 1e6)))
+
+
+    def test2(self):
+        class Foo(object):
+            def __init__(self):
+                self.identifier = 'Foo'
+                self.k = Property('k', 'W/m/K', calc=lambda T, p, x=0.:
+                                  2. + 1e-3 * T)
+        foo = Foo()
+        pack = PropertyPack()
+        self.assertEqual(pack.add_matter(foo, keys=['k'], 
+                                         T_range=(300., 400.), order=1),
+                         ['Foo.k'])
+        pack.save(self.file)
+
+        foo = Foo()
+        self.assertEqual(PropertyPack.load(self.file, mmap=False).apply(foo),
+                         ['k'])
+        self.assertAlmostEqual(foo.k(350., 1e5), 2.35)
+        y, valid = foo.k.eval_batch(T=[350., 500.])
+        self.assertEqual(list(valid), [True, False])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -196,5 +196,46 @@ class TestUM(unittest.TestCase):
         self.assertTrue(True)
 
 
+    def test8(self):
+        print('+++ vectorized Parameter.simulate with seeded streams')
+        print('-' * 40)
+
+        x = Parameter()
+        x.ref = np.linspace(1., 2., num=10**6)
+        x.calibrated = Range('-2%', '+3%', 'flat')   # rel to self.ref
+
+        val = x.simulate(range_key='calibrated', seed=42)
+        dev = (val - x.ref) / x.ref
+        print('relative deviation:', dev.min(), dev.max())
+
+        self.assertEqual(val.shape, x.ref.shape)
+        self.assertTrue((dev >= -0.02 - 1e-12).all())
+        self.assertTrue((dev <= 0.03 + 1e-12).all())
+
+        # reproducible with same seed and stream, different across streams 
+        self.assertTrue(np.array_equal(val, 
+            x.simulate(range_key='calibrated', seed=42)))
+        self.assertFalse(np.array_equal(val, 
+            x.simulate(range_key='calibrated', seed=42, stream=1)))
+
+
+    def test9(self):
+        print('+++ seeded Parameter.simulate with absolute and %FS bounds')
+        print('-' * 40)
+
+        x = Parameter()
+        x.full_scale = Range(0., 200.)
+        for bounds, lo, up in ((( -1., 2.), -1., 2.), 
+                               (('-1%FS', '+2%FS'), -2., 4.)):
+            x.calibrated = Range(bounds[0], bounds[1], 'flat')
+            val = x.simulate(range_key='calibrated', size=1000, seed=7)
+            print('bounds:', bounds, 'min/max:', val.min(), val.max())
+
+            self.assertEqual(val.shape, (1000,))
+            self.assertTrue((val >= lo).all() and (val <= up).all())
+            self.assertTrue(np.array_equal(val, 
+                x.simulate(range_key='calibrated', size=1000, seed=7)))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,81 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.mesh.partly_regular import PartlyRegularMesh, partly_regular
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        self.ranges = [(-2, 3), (0, 3), (0, 2)]
+        self.n = (14, 10, 8)
+        self.spacing = ('log+-', 'log-', 'lin')
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        # dtype is honored for all spacings
+        for dtype in (np.float32, np.float64):
+            X, x, dx, V = partly_regular(self.n, *self.ranges, 
+                                         spacing=self.spacing, dtype=dtype)
+            print('X x dx V:', X.shape, x.shape, dx.shape, V.shape)
+
+            self.assertEqual(X.shape, (3, 15, 11, 9))
+            self.assertEqual(V.shape, (15, 11, 9))
+            for a in (X, x, dx, V):
+                self.assertEqual(a.dtype, dtype)
+
+    def test2(self):
+        # lazy mesh vs. dense tensor products
+        mesh = PartlyRegularMesh(self.n, *self.ranges, spacing=self.spacing,
+                                 dtype=np.float64)
+        X, x, dx, V = mesh.dense()
+        self.assertEqual(mesh.shape, V.shape)
+
+        for j, (X_j, x_j, dx_j) in enumerate(zip(mesh.X_views(), 
+                mesh.x_views(), mesh.dx_views())):
+            self.assertTrue(np.array_equal(np.broadcast_to(X_j, V.shape), 
+                                           X[j]))
+            self.assertTrue(np.array_equal(np.broadcast_to(x_j, V.shape), 
+                                           x[j]))
+            self.assertTrue(np.array_equal(np.broadcast_to(dx_j, V.shape), 
+                                           dx[j]))
+            self.assertTrue(np.shares_memory(dx_j, mesh.dx1d[j]))
+
+        for axis in range(3):
+            for i, V_slab in mesh.iter_V(axis):
+                self.assertTrue(np.allclose(V_slab, np.take(V, i, axis)))
+        self.assertAlmostEqual(mesh.total_volume, V.sum())
+        self.assertAlmostEqual(mesh.total_volume, 5. * 3. * 2.)
+        self.assertAlmostEqual(mesh.volume(3, 4, 5), V[3, 4, 5])
+
+    def test3(self):
+        # 1D with transposed arrays
+        X, x, dx, V = partly_regular(-5, (0, 1))
+        self.assertEqual(X.shape, (6, 1))
+        self.assertTrue(np.allclose(X[:-1, 0], np.linspace(0, 1, 5)))
+
+
+if __name__ == '__main__':
+    unittest.main()
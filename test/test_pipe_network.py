@@ -0,0 +1,100 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.flow.pipe_network import PipeNetwork
+from whiteboxes.flow.pressure_drop import dp_in_red_mid_exp_out
+
+
+D1, L1 = 20e-3, 0.5
+D2, L2 = 10e-3, 0.2
+D3, L3 = 20e-3, 0.5
+nu, rho, eps_rough = 1e-6, 1e3, 10e-6
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        # series network vs. hard-coded series dp_in_red_mid_exp_out()
+        net = PipeNetwork(nu=nu, rho=rho, eps_rough=eps_rough)
+        net.add_pipe(0, 1, D=D1, L=L1)
+        net.add_transition(1, 2, D_from=D1, D_to=D2)
+        net.add_pipe(2, 3, D=D2, L=L2)
+        net.add_transition(3, 4, D_from=D2, D_to=D3)
+        net.add_pipe(4, 5, D=D3, L=L3)
+
+        for v1 in (0.1, 1., 3.):
+            dp = dp_in_red_mid_exp_out(v1=v1, D1=D1, L1=L1, D2=D2, L2=L2, 
+                                       D3=D3, L3=L3, nu=nu, rho=rho, 
+                                       eps_rough=eps_rough)[0]
+            Q, p = net.solve(p_fixed={0: 1e5 + dp, 5: 1e5})
+            print('v1:', v1, 'v:', net.velocity()[0], 'n_iter:', net.n_iter)
+
+            self.assertTrue(net.converged)
+            self.assertTrue(np.allclose(Q, Q[0]))
+            self.assertAlmostEqual(net.velocity()[0], v1, delta=1e-6 * v1)
+
+        # reversed flow: reduction becomes expansion and vice versa
+        Q, p = net.solve(p_fixed={0: 1e5, 5: 1e5 + dp})
+        self.assertTrue(np.all(Q < 0.))
+        self.assertAlmostEqual(-net.velocity()[0], v1, delta=1e-6 * v1)
+
+    def test2(self):
+        # two loops with demands: continuity, symmetric split, warm start
+        net = PipeNetwork(nu=nu, rho=rho)
+        net.add_pipe('in', 'a', D=50e-3, L=10.)
+        net.add_pipe('a', 'b', D=25e-3, L=5.)
+        net.add_pipe('a', 'c', D=25e-3, L=5.)
+        net.add_bend('b', 'd', D=25e-3, r_bend=50e-3, phi_bend_deg=90.)
+        net.add_bend('c', 'd', D=25e-3, r_bend=50e-3, phi_bend_deg=90.)
+        net.add_transition('b', 'c', D_from=25e-3, D_to=20e-3, 
+                           alpha_deg=30.)
+        net.add_resistance('d', 'out', D=50e-3, k=1.5)
+        demand = {'b': 1e-4, 'c': 1e-4}
+
+        Q, p = net.solve(p_fixed={'in': 3e5, 'out': 1e5}, demand=demand,
+                         warm_start=False)
+        n_iter_cold = net.n_iter
+        self.assertTrue(net.converged)
+
+        B = net._compile()['B']
+        outflow = B.T @ Q
+        for node in ('a', 'b', 'c', 'd'):
+            self.assertAlmostEqual(outflow[net.nodes[node]] + 
+                                   demand.get(node, 0.), 0., delta=1e-12)
+        self.assertAlmostEqual(Q[0], Q[6] + 2e-4, delta=1e-12)
+        self.assertTrue(np.allclose(net.dp(Q), B @ p, rtol=1e-6, atol=1e-3))
+
+        Q2, p2 = net.solve(p_fixed={'in': 3.1e5, 'out': 1e5}, demand=demand)
+        print('n_iter cold:', n_iter_cold, 'warm:', net.n_iter)
+        self.assertTrue(net.converged and net.n_iter < n_iter_cold)
+        self.assertTrue(Q2[0] > Q[0])
+
+
+if __name__ == '__main__':
+    unittest.main()
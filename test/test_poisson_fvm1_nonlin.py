@@ -0,0 +1,146 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.heat.poisson_fvm1_nonlin import (poisson_bc1_bc1_fvm1,
+    poisson_bc1_bc1_nonlin_fvm1, dqdt_for_bc1_seq)
+from whiteboxes.mesh.distribution import Distribution
+from whiteboxes.mesh.partly_regular import PartlyRegularMesh
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        k_coeff = (1., 0.1, 1e-3)
+        conductivity = lambda x, T: 1. + T * (0.1 + T * 1e-3)
+        T = {}
+        for assembly in ('loop', 'vectorized', 'compiled'):
+            x, T[assembly], dTdx_west, dTdx_east = poisson_bc1_bc1_fvm1(
+                n_vol=100, T_west=0., T_east=100., assembly=assembly,
+                conductivity=conductivity, k_coeff=k_coeff)
+            print(assembly, ': dTdx_west:', dTdx_west)
+
+        self.assertTrue(np.allclose(T['loop'], T['vectorized']))
+        self.assertTrue(np.allclose(T['loop'], T['compiled']))
+
+    def test2(self):
+        dqdt_west, dqdt_east = dqdt_for_bc1_seq(k_coeff=(1., 0.01),
+            T_west=(0., 50.), T_east=100., n_vol=100)
+        print('dqdt_west:', dqdt_west, 'dqdt_east:', dqdt_east)
+
+        self.assertEqual(dqdt_west.shape, (2,))
+
+    def test3(self):
+        k_coeff = (1., 0.05, 1e-3)
+        res = {}
+        for method in ('picard', 'newton', 'anderson'):
+            res[method] = poisson_bc1_bc1_nonlin_fvm1(n_vol=200, 
+                T_west=0., T_east=100., k_coeff=k_coeff, method=method, 
+                mse=1e-10, max_it=100)
+            print(method, ': it:', res[method]['it'], 'time:', 
+                  res[method]['hist_time'][-1])
+
+        self.assertTrue(np.allclose(res['picard']['T'], res['newton']['T'], 
+                                    atol=1e-4))
+        self.assertTrue(np.allclose(res['picard']['T'], 
+                                    res['anderson']['T'], atol=1e-4))
+        self.assertLessEqual(res['newton']['it'], res['picard']['it'])
+
+    def test4(self):
+        kwargs = dict(k_coeff=(1., 0.01), T_west=(0., 20., 40.), 
+                      T_east=(50., 100.), n_vol=100, mse=1e-8)
+        seq = dqdt_for_bc1_seq(n_jobs=1, warm_start=False, **kwargs)
+        for executor in ('thread', 'process'):
+            par = dqdt_for_bc1_seq(n_jobs=2, chunk_size=2, 
+                                   executor=executor, **kwargs)
+            print(executor, ':', par[0])
+
+            self.assertEqual(par[0].shape, (6,))
+            self.assertTrue(np.allclose(seq[0], par[0], rtol=1e-3))
+            self.assertTrue(np.allclose(seq[1], par[1], rtol=1e-3))
+
+    def test5(self):
+        kwargs = dict(k_coeff=(1., 0.01), T_west=(0., 20., 40.), 
+                      T_east=(50., 100.), n_vol=100, mse=1e-8)
+        seq = dqdt_for_bc1_seq(**kwargs)
+        bat = dqdt_for_bc1_seq(batched=True, **kwargs)
+        print('batched:', bat[0])
+
+        self.assertTrue(np.allclose(seq[0], bat[0], rtol=1e-3))
+        self.assertTrue(np.allclose(seq[1], bat[1], rtol=1e-3))
+
+    def test6(self):
+        # boundary layer at east: T = sinh(m x) / sinh(m), dq/dt = m coth(m)
+        m, n_vol = 50., 40
+        dqdt_exact = m / np.tanh(m)
+        meshes = {'uniform': None,
+                  'log+': PartlyRegularMesh((n_vol+1,), (0., 1.), 
+                                            spacing='log+', dtype=np.float64),
+                  'LOG_PLUS': Distribution.LOG_PLUS}
+        error = {}
+        for key, mesh in meshes.items():
+            res = poisson_bc1_bc1_nonlin_fvm1(n_vol=n_vol, mesh=mesh, 
+                T_west=0., T_east=1., k_coeff=(1.,), s_coeff=(0., -m**2), 
+                method='newton', mse=1e-14)
+            error[key] = abs(res['dqdt_east'] / dqdt_exact - 1)
+            print(key, ': rel error of dqdt_east:', error[key])
+
+            self.assertEqual(res['x'].size, n_vol + 2)
+        self.assertLess(error['log+'], error['uniform'])
+        self.assertLess(error['LOG_PLUS'], error['uniform'])
+
+        # externally generated faces of uniform mesh
+        x, T, _, _ = poisson_bc1_bc1_fvm1(n_vol=n_vol, T_east=100.)
+        x_ext, T_ext, _, _ = poisson_bc1_bc1_fvm1(
+            mesh=np.linspace(0., 1., n_vol+1), T_east=100.)
+        self.assertTrue(np.allclose(x, x_ext))
+        self.assertTrue(np.allclose(T, T_ext))
+
+        # size of mesh is validated instead of 'n_vol'
+        faces = np.linspace(0., 1., 11)
+        self.assertIsNone(poisson_bc1_bc1_fvm1(mesh=faces[:3]))
+        self.assertIsNone(poisson_bc1_bc1_nonlin_fvm1(mesh=faces[:3]))
+        x, T, _, _ = poisson_bc1_bc1_fvm1(mesh=faces, n_vol=2)
+        self.assertEqual(x.size, 12)
+        res = poisson_bc1_bc1_nonlin_fvm1(mesh=faces, n_vol=2)
+        self.assertEqual(res['x'].size, 12)
+
+    def test7(self):
+        kwargs = dict(k_coeff=(1., 0.01), T_west=(0., 20., 40.), 
+                      T_east=(50., 100.), n_vol=100, mse=1e-8, 
+                      mesh=Distribution.LOG_PLUS_MINUS)
+        seq = dqdt_for_bc1_seq(**kwargs)
+        bat = dqdt_for_bc1_seq(batched=True, **kwargs)
+        print('graded, batched:', bat[0])
+
+        self.assertTrue(np.allclose(seq[0], bat[0], rtol=1e-3))
+        self.assertTrue(np.allclose(seq[1], bat[1], rtol=1e-3))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -297,6 +297,43 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+    def test10(self):
+        # vectorized friction factor vs. element-wise bracketed search
+        Re_seq = np.logspace(2, 8, 200)
+        eps_seq = np.array([0., 1e-6, 1e-4, 1e-3]).reshape(-1, 1)
+        f_vec = poiseulle_colebrook(Re_seq, D1, eps_seq)
+        f_bis = poiseulle_colebrook(Re_seq, D1, eps_seq, 
+                                    bi_sectional_search=True)
+        f_scalar = poiseulle_colebrook(Re_seq[-1], D1, eps_seq[1, 0])
+        print('f_vec.shape:', f_vec.shape, 'f_scalar:', f_scalar)
+
+        self.assertEqual(f_vec.shape, (4, 200))
+        self.assertIsInstance(f_scalar, float)
+        self.assertTrue(np.allclose(f_vec, f_bis, rtol=1e-8))
+        self.assertAlmostEqual(f_scalar, f_vec[1, -1])
+        laminar = Re_seq <= 2300
+        self.assertTrue(np.allclose(f_vec[:, laminar], 64. / Re_seq[laminar]))
+
+    def test11(self):
+        # array mode of pressure drop chain vs. loop over scalar calls
+        v1_arr = np.linspace(0., 10., 21)
+        D2_arr = np.array([4e-3, 5e-3, 6e-3]).reshape(-1, 1)
+        for function in (dp_in_red_mid_exp_out, 
+                         dp_tapered_in_red_mid_exp_out):
+            dp_arr = function(v1=v1_arr, D1=D1, L1=L1, D2=D2_arr, L2=L2, 
+                              D3=D3, L3=L3, nu=nu, rho=rho, 
+                              eps_rough=eps_rough)
+            self.assertEqual(len(dp_arr), 6)
+            self.assertEqual(dp_arr[0].shape, (3, 21))
+            for i, D2_ in enumerate(D2_arr[:, 0]):
+                for j, v1_ in enumerate(v1_arr):
+                    dp = function(v1=float(v1_), D1=D1, L1=L1, D2=float(D2_),
+                                  L2=L2, D3=D3, L3=L3, nu=nu, rho=rho, 
+                                  eps_rough=eps_rough)
+                    dp = np.zeros(6) if np.ndim(dp) == 0 else dp
+                    self.assertTrue(np.allclose([x[i, j] for x in dp_arr], 
+                                                dp))
+
 
 if __name__ == '__main__':
     unittest.main()
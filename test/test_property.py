@@ -131,5 +131,117 @@ class TestUM(unittest.TestCase):
 
         self.assertTrue(True)
 
+
+    def test5(self):
+        foo = Property(identifier='abc')
+        foo.calc = lambda T, p, x=0: 0.1 + 1e-3*T - 1e-4*p if T > 0 else None
+
+        T = np.linspace(-10, 100, 12)
+        p = np.array([1., 2.]).reshape(2, 1)
+
+        # element-wise fallback
+        y_loop, valid_loop = foo.eval_batch(T, p)
+
+        # vectorized kernel
+        foo.calc_vec = lambda T, p, x: np.where(T > 0, 
+            0.1 + 1e-3*T - 1e-4*p, np.nan)
+        y_vec, valid_vec = foo.eval_batch(T, p)
+
+        print('y_vec:', y_vec)
+        print('-' * 79)
+
+        self.assertEqual(y_vec.shape, (2, 12))
+        self.assertTrue(np.array_equal(valid_loop, valid_vec))
+        self.assertTrue(np.allclose(y_loop[valid_loop], y_vec[valid_vec]))
+        self.assertFalse(valid_vec[:, 0].any())
+
+    def test6(self):
+        foo = Property(identifier='abc')
+        foo.calc = lambda T, p, x=0: 2. + 3e-3*T * np.exp(-1e-6*p) + x*x
+        T, p, x = 300., 2e5, 0.5
+        
+        # dual numbers
+        y, grad = foo.grad(T, p, x)
+        exact = [3e-3 * np.exp(-1e-6*p), -3e-9 * T * np.exp(-1e-6*p), 2*x]
+        print('y:', y, 'grad:', grad, 'exact:', exact)
+        
+        self.assertAlmostEqual(y, foo(T, p, x))
+        self.assertTrue(np.allclose(grad, exact, rtol=1e-12))
+        self.assertAlmostEqual(foo.derivative(T, p, x, 'p'), exact[1])
+
+        # finite difference fallback if calc() converts its arguments 
+        foo.calc = lambda T, p, x=0: 2. + 3e-3*float(T)
+        y, grad = foo.grad(T, p, x)
+        self.assertAlmostEqual(grad[0], 3e-3)
+
+    def test7(self):
+        foo = Property(identifier='k', calc=25.)
+        self.assertIsNotNone(foo.calc_vec)
+        self.assertIsNotNone(foo.calc_grad)
+        
+        y, valid = foo.eval_batch(np.linspace(300., 400., 5), [[1e5], [2e5]])
+        print('constant:', foo.constant_value, 'batch:', y)
+
+        self.assertTrue(foo.is_constant)
+        self.assertEqual(foo(), 25.)
+        self.assertEqual(foo.calc(300., 1e5, 0.), 25.)
+        self.assertEqual(y.shape, (2, 5))
+        self.assertTrue(valid.all() and (y == 25.).all())
+        self.assertTrue((foo.grad(300., 1e5)[1] == 0.).all())
+
+        foo.calc = lambda T, p, x: 25. + 1e-3 * T
+        self.assertFalse(foo.is_constant)
+        self.assertIsNone(foo.constant_value)
+        self.assertAlmostEqual(foo.to_number(300.), 25.3)
+
+    def test8(self):
+        n_calls = [0]
+        def calc(T, p, x=0.):
+            n_calls[0] += 1
+            return 1. + 1e-3 * T
+        foo = Property(identifier='k', calc=calc)
+        foo.memoize(maxsize=2, tol=(1e-3, 1., 0.))
+
+        y = [foo(300., 1e5), foo(300.0001, 1e5), foo(301., 1e5), 
+             foo(300., 1e5)]
+        print('memo_stats:', foo.memo_stats)
+
+        self.assertEqual(n_calls[0], 2)
+        self.assertEqual(y[0], y[1])
+        self.assertEqual(foo.memo_stats['hits'], 2)
+        self.assertEqual(foo.memo_stats['size'], 2)
+
+        # cache is cleared if reference value or function are changed
+        foo.x.ref = 0.5
+        foo(300., 1e5)
+        self.assertEqual(n_calls[0], 3)
+        foo.calc = lambda T, p, x=0.: 2.
+        self.assertEqual(foo(300., 1e5), 2.)
+
+        # arrays are not cached, memoization can be disabled
+        self.assertEqual(foo(np.array([300., 301.]), 1e5), 2.)
+        foo.memoize(None)
+        self.assertIsNone(foo.memo_stats)
+
+
+    def test9(self):
+        foo = Property(identifier='k')
+        foo.calc = lambda T, p, x=0.: 1. - 2e-3 * T + 3e-6 * T**2 - 4e-9 * T**3
+
+        for order in (1, 'quadratic', 'cub', 5):
+            c = foo.regression_fit(T_range=(300., 500.), order=order)
+            print(order, c, foo.regression_max_rel_error)
+        self.assertEqual(len(c), 6)
+        self.assertTrue(np.allclose(c[:4], [1., -2e-3, 3e-6, -4e-9]))
+        self.assertLess(foo.regression_max_rel_error, 1e-10)
+
+        T = np.linspace(300., 500., 5)
+        self.assertTrue(np.allclose(foo.regression_prediction(T),
+                                    foo.calc(T, 0.)))
+        self.assertAlmostEqual(foo.regression_prediction(400.), 
+                               foo.calc(400., 0.))
+        self.assertIsNone(foo.regression_fit(order=0))
+
+
 if __name__ == '__main__':
     unittest.main()
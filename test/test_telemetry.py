@@ -0,0 +1,90 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import csv
+import json
+import numpy as np
+import os
+from tempfile import gettempdir
+import unittest
+
+from whiteboxes.flow.pressure_drop import poiseulle_colebrook
+from whiteboxes.heat.poisson_fvm1_nonlin import poisson_bc1_bc1_nonlin_fvm1
+from whiteboxes.property.property import Property
+from whiteboxes.tools import telemetry
+from whiteboxes.tools.telemetry import Telemetry
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        pass
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        # disabled mode: nothing is recorded
+        tel = Telemetry()
+        poisson_bc1_bc1_nonlin_fvm1(n_vol=50, k_coeff=(1., 0.1))
+
+        self.assertIsNone(telemetry.ACTIVE)
+        self.assertEqual(tel.records, [])
+
+    def test2(self):
+        k = Property('k', 'W/m/K')
+        k.calc = lambda T, p=0., x=0.: 1. + 0.1 * T
+        with Telemetry() as tel:
+            res = poisson_bc1_bc1_nonlin_fvm1(n_vol=50, method='newton', 
+                conductivity=lambda x, T: k(T), mse=1e-12)
+            poiseulle_colebrook(np.logspace(4, 6, 10), 0.05, 1e-5)
+        summary = tel.summary()
+        print('summary:', summary)
+
+        self.assertIsNone(telemetry.ACTIVE)
+        s = summary['poisson_bc1_bc1_nonlin_fvm1']
+        self.assertEqual(s['n_iterations'], res['it'] + 1)
+        self.assertEqual(s['exit'], 'converged')
+        self.assertGreater(s['n_property'], 0)
+        self.assertEqual(summary['poiseulle_colebrook']['n_iterations'], 5)
+
+    def test3(self):
+        with Telemetry(track_memory=True) as tel:
+            for it in range(3):
+                telemetry.count('coolprop', 2)
+                telemetry.iteration('foo', it, 10.**-it)
+            telemetry.event('foo', 'converged', it, 1e-2)
+        file = os.path.join(gettempdir(), 'test_telemetry')
+        tel.to_json(file + '.json')
+        tel.to_csv(file + '.csv')
+        with open(file + '.json') as f:
+            data = json.load(f)
+        with open(file + '.csv', newline='') as f:
+            rows = list(csv.DictReader(f))
+
+        self.assertEqual(data['counters']['coolprop'], 6)
+        self.assertEqual(data['summary']['foo']['exit'], 'converged')
+        self.assertEqual(len(rows), 4)
+        self.assertEqual(rows[1]['n_coolprop'], '2')
+        self.assertIn('mem_peak', rows[0])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,69 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+import numpy as np
+import unittest
+
+from whiteboxes.property.parameter import Parameter
+from whiteboxes.property.range import Range
+from whiteboxes.property.uncertainty import (InputDistribution, 
+    input_from_parameter, propagate)
+
+
+class TestUM(unittest.TestCase):
+    def setUp(self):
+        # y = 2 a + 3 b, std(a) = 0.1, std(b) = 0.2
+        self.func = lambda a, b: 2. * a + 3. * b
+        self.inputs = {'a': InputDistribution(1., -0.15, 0.15, 'gauss'), 
+                       'b': InputDistribution(2., -0.3, 0.3, 'gauss')}
+        self.std = np.sqrt((2. * 0.1)**2 + (3. * 0.2)**2)
+
+    def tearDown(self):
+        pass
+
+    def test1(self):
+        for method in ('linear', 'unscented'):
+            res = propagate(self.func, self.inputs, method=method)
+            print(method, res['mean'], res['std'], (res['lo'], res['up']))
+
+            self.assertAlmostEqual(res['mean'], 8.)
+            self.assertAlmostEqual(res['std'], self.std, delta=1e-8)
+
+    def test2(self):
+        res = propagate(self.func, self.inputs, method='lhs', 
+                        n_samples=20000, seed=1, n_jobs=4)
+        print('lhs', res['mean'], res['std'], (res['lo'], res['up']))
+
+        self.assertEqual(res['y'].shape, (20000,))
+        self.assertAlmostEqual(res['mean'], 8., delta=0.01)
+        self.assertAlmostEqual(res['std'], self.std, delta=0.01)
+        self.assertTrue(res['lo'] < 8. < res['up'])
+
+    def test3(self):
+        par = Parameter(ref=50.)
+        par.accuracy = Range('-2%', '2%', 'flat')
+        dist = input_from_parameter(par)
+
+        self.assertAlmostEqual(dist.mean, 50.)
+        self.assertAlmostEqual(dist.std, 2. / np.sqrt(12.))
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,486 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+__all__ = ['PipeNetwork']
+
+import numpy as np
+from scipy.sparse import csr_matrix, diags
+from scipy.sparse.linalg import spsolve
+from typing import Any, Dict, Hashable, Iterable, List, Optional, Tuple
+
+from whiteboxes.flow.pressure_drop import (resistance_pipe, 
+    resistance_pipe_bend, resistance_square_pipe_expansion, 
+    resistance_square_pipe_reduction, resistance_tapered_pipe_expansion,
+    resistance_tapered_pipe_reduction)
+from whiteboxes.tools import telemetry
+
+# lower limit of velocity in evaluation of resistance coefficients [m/s]
+V_MIN = 1e-4
+
+
+class PipeNetwork(object):
+    """
+    Network of hydraulic components (branches) connected at junctions 
+    (nodes). The flow distribution is found for given pressures at 
+    boundary nodes and given demands at inner nodes
+
+          p_fixed                                          p_fixed
+            o-----pipe-----o-----bend-----o----transition----o
+                           |              |
+                           +-----pipe-----+---pipe---o demand
+
+    Unknowns are the volume flow rates Q of all branches and the 
+    pressures p of all free nodes:
+
+        momentum per branch:      dp_b(Q_b) - (p_from - p_to) = 0
+        continuity per free node: sum of Q leaving - sum of Q entering 
+                                  + demand = 0
+
+    The nonlinear system is solved by the global gradient algorithm 
+    (Todini & Pilati), a Newton method replacing Hardy Cross:
+    - pressure corrections of all free nodes are solved together from 
+      the sparse, symmetric matrix  B_f^T G^-1 B_f  (B: incidence 
+      matrix, G: diagonal of d(dp)/dQ)
+    - resistance coefficients of all branches of one component type are
+      evaluated in a single vectorized call per iteration, including 
+      the perturbed flow rates for G
+    - flow rates and pressures of the last solution are the initial 
+      values of the next solve() (warm start), as long as the topology
+      is unchanged
+
+    Example:
+        net = PipeNetwork(nu=1e-6, rho=1e3)
+        net.add_pipe('in', 'a', D=50e-3, L=10.)
+        net.add_bend('a', 'b', D=50e-3, r_bend=100e-3, phi_bend_deg=90.)
+        net.add_transition('b', 'c', D_from=50e-3, D_to=25e-3)
+        net.add_pipe('c', 'out', D=25e-3, L=5.)
+        Q, p = net.solve(p_fixed={'in': 2e5, 'out': 1e5})
+
+    Note:
+        Flow rate Q_b is positive in direction from node 'from' to node 
+        'to' of branch b. The resistance of a transition depends on flow 
+        direction: it is a reduction if the fluid enters at the larger
+        diameter, otherwise an expansion
+    """
+
+    KINDS = ('pipe', 'bend', 'transition', 'fixed')
+
+    def __init__(self, nu: float = 1e-6, rho: float = 1e3, 
+                 eps_rough: float = 10e-6) -> None:
+        """
+        Args:
+            nu:
+                kinematic viscosity of fluid [m^2/s]
+
+            rho:
+                density of fluid [kg/m^3]
+
+            eps_rough:
+                default inner pipe roughness [m]
+        """
+        self.nu = nu
+        self.rho = rho
+        self.eps_rough = eps_rough
+
+        self.nodes: Dict[Hashable, int] = {}
+        self.branches: List[Dict[str, Any]] = []
+
+        self.Q: Optional[np.ndarray] = None
+        self.p: Optional[np.ndarray] = None
+        self.n_iter: int = 0
+        self.converged: bool = False
+
+        self._compiled: Optional[Dict[str, Any]] = None
+
+    def _node(self, node: Hashable) -> int:
+        if node not in self.nodes:
+            self.nodes[node] = len(self.nodes)
+        return self.nodes[node]
+
+    def _add(self, kind: str, node_from: Hashable, node_to: Hashable, 
+             D: float, **par: float) -> int:
+        assert kind in self.KINDS, str(kind)
+        assert node_from != node_to, str(node_from)
+        assert D > 0., str(D)
+        par.setdefault('eps_rough', self.eps_rough)
+        self.branches.append({'kind': kind, 
+                              'from': self._node(node_from), 
+                              'to': self._node(node_to), 'D': D, **par})
+
+        # topology changed: warm start and compiled arrays are invalid
+        self._compiled = None
+        self.Q, self.p = None, None
+        return len(self.branches) - 1
+
+    def add_pipe(self, node_from: Hashable, node_to: Hashable, D: float, 
+                 L: float, eps_rough: Optional[float] = None) -> int:
+        """
+        Adds straight pipe, see resistance_pipe()
+
+        Args:
+            node_from, node_to:
+                identifiers of connected nodes
+
+            D:
+                inner pipe diameter [m]
+
+            L:
+                pipe length [m]
+
+            eps_rough:
+                inner pipe roughness [m]. If None, network default is 
+                used
+
+        Returns:
+            index of branch
+        """
+        return self._add('pipe', node_from, node_to, D, L=L, 
+                         **self._eps(eps_rough))
+
+    def add_bend(self, node_from: Hashable, node_to: Hashable, D: float, 
+                 r_bend: float, phi_bend_deg: float,
+                 eps_rough: Optional[float] = None) -> int:
+        """
+        Adds pipe bend, see resistance_pipe_bend()
+
+        Args:
+            node_from, node_to:
+                identifiers of connected nodes
+
+            D:
+                inner pipe diameter [m]
+
+            r_bend:
+                bending radius [m]
+
+            phi_bend_deg:
+                bending angle [deg]
+
+            eps_rough:
+                inner pipe roughness [m]. If None, network default is 
+                used
+
+        Returns:
+            index of branch
+        """
+        return self._add('bend', node_from, node_to, D, r_bend=r_bend, 
+                         phi_bend_deg=phi_bend_deg, **self._eps(eps_rough))
+
+    def add_transition(self, node_from: Hashable, node_to: Hashable, 
+                       D_from: float, D_to: float, 
+                       alpha_deg: Optional[float] = None,
+                       eps_rough: Optional[float] = None) -> int:
+        """
+        Adds change of pipe diameter, which is a reduction or an expansion 
+        depending on flow direction, see resistance_square_pipe_*() and
+        resistance_tapered_pipe_*()
+
+        Args:
+            node_from, node_to:
+                identifiers of connected nodes
+
+            D_from:
+                inner pipe diameter at node 'from' [m]
+
+            D_to:
+                inner pipe diameter at node 'to' [m]
+
+            alpha_deg:
+                opening angle (over both sides) [deg]. If None, 
+                transition is square
+
+            eps_rough:
+                inner pipe roughness [m]. If None, network default is 
+                used
+
+        Returns:
+            index of branch
+        """
+        assert D_to > 0., str(D_to)
+        return self._add('transition', node_from, node_to, D_from, 
+                         D_to=D_to, 
+                         alpha_deg=np.nan if alpha_deg is None else alpha_deg,
+                         **self._eps(eps_rough))
+
+    def add_resistance(self, node_from: Hashable, node_to: Hashable, 
+                       D: float, k: float) -> int:
+        """
+        Adds component with constant resistance coefficient, e.g. valve
+
+        Args:
+            node_from, node_to:
+                identifiers of connected nodes
+
+            D:
+                reference diameter of velocity in pressure drop [m]
+
+            k:
+                resistance coefficient [/]
+
+        Returns:
+            index of branch
+        """
+        return self._add('fixed', node_from, node_to, D, k=k)
+
+    def _eps(self, eps_rough: Optional[float]) -> Dict[str, float]:
+        return {} if eps_rough is None else {'eps_rough': eps_rough}
+
+    @property
+    def n_nodes(self) -> int:
+        return len(self.nodes)
+
+    @property
+    def n_branches(self) -> int:
+        return len(self.branches)
+
+    def _compile(self) -> Dict[str, Any]:
+        """
+        Builds incidence matrix and parameter arrays per component type
+
+        Returns:
+            compiled network, valid until topology changes
+        """
+        if self._compiled is not None:
+            return self._compiled
+
+        n_b = self.n_branches
+        from_ = np.array([b['from'] for b in self.branches], dtype=np.int64)
+        to = np.array([b['to'] for b in self.branches], dtype=np.int64)
+        D = np.array([b['D'] for b in self.branches])
+
+        # incidence: (B @ p)[b] = p[from] - p[to]
+        B = csr_matrix((np.r_[np.ones(n_b), -np.ones(n_b)],
+                        (np.r_[np.arange(n_b), np.arange(n_b)], 
+                         np.r_[from_, to])), shape=(n_b, self.n_nodes))
+
+        groups = {}
+        for kind in self.KINDS:
+            idx = np.array([i for i, b in enumerate(self.branches) 
+                            if b['kind'] == kind], dtype=np.int64)
+            if idx.size:
+                keys = [key for key in self.branches[idx[0]] 
+                        if key not in ('kind', 'from', 'to')]
+                par = {key: np.array([self.branches[i][key] for i in idx],
+                                     dtype=float) for key in keys}
+                groups[kind] = (idx, par)
+
+        self._compiled = {'B': B, 'area': 0.25 * np.pi * D**2, 
+                          'groups': groups}
+        return self._compiled
+
+    def _k(self, kind: str, par: Dict[str, np.ndarray], 
+           v: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Resistance coefficients of all branches of one component type
+
+        Args:
+            kind:
+                component type, see KINDS
+
+            par:
+                parameter arrays of branches of this type
+
+            v:
+                velocity at node 'from', shape (..., n_branches_of_kind)
+
+        Returns:
+            resistance coefficients and reference velocities of pressure 
+            drop
+        """
+        nu = self.nu
+        vc = np.maximum(np.abs(v), V_MIN)
+        if kind == 'pipe':
+            return resistance_pipe(vc, par['D'], par['L'], nu, 
+                                   par['eps_rough']), v
+        if kind == 'bend':
+            return resistance_pipe_bend(vc, par['D'], par['r_bend'], 
+                par['phi_bend_deg'], nu, par['eps_rough']), v
+        if kind == 'fixed':
+            return np.broadcast_to(par['k'], v.shape), v
+
+        # transition: inlet is at node 'from' if flow is positive
+        forward = v >= 0.
+        D_in = np.where(forward, par['D'], par['D_to'])
+        D_out = np.where(forward, par['D_to'], par['D'])
+        v_in = v * (par['D'] / D_in)**2
+        vc = np.maximum(np.abs(v_in), V_MIN)
+        eps, alpha = par['eps_rough'], par['alpha_deg']
+        square = np.isnan(alpha)
+        alpha = np.where(square, 90., alpha)
+        reduction = D_in > D_out
+        k = np.where(square,
+            np.where(reduction, 
+                     resistance_square_pipe_reduction(vc, D_in, D_out, nu, eps),
+                     resistance_square_pipe_expansion(vc, D_in, D_out, nu, eps)),
+            np.where(reduction, 
+                     resistance_tapered_pipe_reduction(vc, D_in, D_out, nu, 
+                                                       eps, alpha),
+                     resistance_tapered_pipe_expansion(vc, D_in, D_out, nu, 
+                                                       eps, alpha)))
+        return k, v_in
+
+    def dp(self, Q: np.ndarray) -> np.ndarray:
+        """
+        Pressure drops of all branches in direction of positive flow
+
+        Args:
+            Q:
+                volume flow rates of branches [m^3/s], 
+                shape (..., n_branches)
+
+        Returns:
+            pressure drops p_from - p_to [Pa], same shape as Q
+        """
+        net = self._compile()
+        Q = np.asfarray(Q)
+        v = Q / net['area']
+        dp = np.zeros(Q.shape)
+        for kind, (idx, par) in net['groups'].items():
+            k, v_ref = self._k(kind, par, v[..., idx])
+            dp[..., idx] = 0.5 * self.rho * k * v_ref * np.abs(v_ref)
+        return dp
+
+    def solve(self, p_fixed: Dict[Hashable, float], 
+              demand: Optional[Dict[Hashable, float]] = None,
+              warm_start: bool = True,
+              tol: float = 1e-8,
+              max_iter: int = 100,
+              silent: bool = True) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Computes flow distribution
+
+        Args:
+            p_fixed:
+                pressures of boundary nodes {node: p [Pa]}, at least one
+
+            demand:
+                volume flow rates leaving the network at free nodes 
+                {node: demand [m^3/s]}, negative values are supplies
+
+            warm_start:
+                if True, then solution of last call is initial value
+
+            tol:
+                upper limit of relative change of flow rates
+
+            max_iter:
+                maximum number of Newton iterations
+
+            silent:
+                if False, then progress is printed
+
+        Returns:
+            Q: volume flow rates of branches [m^3/s], order of addition
+            p: pressures of nodes [Pa], order of node indices in 'nodes'
+
+        Note:
+            Convergence is reported in 'converged' and 'n_iter'
+        """
+        assert p_fixed, 'at least one node pressure is required'
+        assert max_iter >= 1, str(max_iter)
+        net = self._compile()
+        B, area = net['B'], net['area']
+        n_b, n_n = self.n_branches, self.n_nodes
+
+        fixed = np.zeros(n_n, dtype=bool)
+        p_bc = np.zeros(n_n)
+        for node, p_ in p_fixed.items():
+            fixed[self.nodes[node]] = True
+            p_bc[self.nodes[node]] = p_
+        free = np.flatnonzero(~fixed)
+        q_out = np.zeros(n_n)
+        for node, q in (demand or {}).items():
+            q_out[self.nodes[node]] = q
+
+        if warm_start and self.Q is not None:
+            Q, p = self.Q.copy(), self.p.copy()
+        else:
+            Q, p = area * 1., np.full(n_n, np.mean(list(p_fixed.values())))
+        p[fixed] = p_bc[fixed]
+
+        B_f = B[:, free]
+        B_fT = B_f.T.tocsr()
+        self.converged = False
+        change = np.inf
+        for it in range(1, max_iter + 1):
+            # values and perturbed values of all branches in one batch
+            h = 1e-6 * np.maximum(np.abs(Q), area * 1e-3)
+            dp = self.dp(np.stack((Q, Q + h)))
+            G = (dp[1] - dp[0]) / h
+            G = np.maximum(G, 1e-9 * np.abs(G).max() + 1e-30)
+
+            r = dp[0] - B @ p
+            c = -q_out[free] - B_fT @ Q
+            A = (B_fT @ diags(1. / G) @ B_f).tocsc()
+            dp_free = np.atleast_1d(spsolve(A, c + B_fT @ (r / G)))
+            dQ = (B_f @ dp_free - r) / G
+
+            p[free] += dp_free
+            Q += dQ
+
+            change = np.abs(dQ).max() / max(np.abs(Q).max(), 1e-20)
+            telemetry.iteration('PipeNetwork.solve', it, change)
+            if not silent:
+                print('+++ iteration:', it, 'change:', change)
+            if change < tol:
+                self.converged = True
+                break
+        self.n_iter = it
+        telemetry.event('PipeNetwork.solve', 
+                        'converged' if self.converged else 'max_iter', 
+                        self.n_iter, change)
+
+        self.Q, self.p = Q, p
+        return Q, p
+
+    def velocity(self, Q: Optional[np.ndarray] = None) -> np.ndarray:
+        """
+        Args:
+            Q:
+                volume flow rates of branches [m^3/s]. If None, last 
+                solution is used
+
+        Returns:
+            mean velocities at node 'from' of branches [m/s]
+        """
+        return (self.Q if Q is None else Q) / self._compile()['area']
+
+
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    ALL = 1
+
+    if 0 or ALL:
+        # cooling water loop with two parallel branches
+        net = PipeNetwork(nu=1e-6, rho=1e3)
+        net.add_pipe('in', 'a', D=50e-3, L=10.)
+        net.add_bend('a', 'b', D=50e-3, r_bend=100e-3, phi_bend_deg=90.)
+        net.add_transition('b', 'c', D_from=50e-3, D_to=25e-3)
+        net.add_pipe('c', 'd', D=25e-3, L=5.)
+        net.add_pipe('b', 'd', D=32e-3, L=8.)
+        net.add_resistance('d', 'out', D=32e-3, k=2.)
+        for dp_total in (0.5e5, 1e5, 2e5):
+            Q, p = net.solve(p_fixed={'in': 1e5 + dp_total, 'out': 1e5})
+            print('dp:', dp_total, 'iterations:', net.n_iter, 
+                  'Q [l/s]:', np.round(Q * 1e3, 3))
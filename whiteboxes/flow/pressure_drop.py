@@ -23,6 +23,10 @@
       Blevins: Applied fluid dynamics handbook, table 6-5, p. 57
       https://neutrium.net/fluid_flow/
               pressure-drop-from-fittings-expansion-and-reduction-in-pipe-size/
+
+  Note
+      Arguments of all functions can be floats or arrays which broadcast
+      together. Functions return floats if all arguments are floats
 """
 
 __all__ = ['pressure_drop',
@@ -36,14 +40,30 @@ __all__ = ['pressure_drop',
            'dp_in_red_mid_exp_out', 
            'dp_tapered_in_red_mid_exp_out']
 
-from math import log10, fabs, sqrt, sin, radians
-from scipy.optimize import fsolve
 import numpy as np
 
+from whiteboxes.tools import telemetry
+
 # upper limit of laminar pipe flow range of Reynolds numbers
 REYNOLDS_PIPE_LAMINAR = 2300
 
 
+def _is_scalar(*args):
+    """
+    Returns:
+        True if all arguments are scalars
+    """
+    return all(np.ndim(x) == 0 for x in args)
+
+
+def _out(y, scalar):
+    """
+    Returns:
+        y as float if 'scalar' is True, otherwise y as array
+    """
+    return float(y) if scalar else np.asfarray(y)
+
+
 def pressure_drop(k, v, rho):
     """
     Pressure drop in hydraulic component from given resistance coefficient
@@ -65,47 +85,113 @@ def pressure_drop(k, v, rho):
     return k * v*v * 0.5 * rho
 
 
-def poiseulle_colebrook(Re, D, eps_rough, bi_sectional_search=False):
+def _colebrook_residual(y, a, b):
+    """
+    Residual of Colebrook equation in the variable y = 1 / (2 sqrt(f)):
+        g(y) = y + log10(a + b * y)
+    g(y) is monotonically increasing for y > 0
+    """
+    return y + np.log10(a + b * y)
+
+
+def _colebrook_bisection(a, b, y_lo=1e-3, y_hi=1e2, n_it=64):
+    """
+    Bracketed root of Colebrook equation for arrays a and b, 
+    see _colebrook_residual()
+
+    Returns:
+        array of y = 1 / (2 sqrt(f))
+    """
+    y_lo = np.full(np.shape(a), y_lo)
+    y_hi = np.full(np.shape(a), y_hi)
+    for _ in range(n_it):
+        y_mid = 0.5 * (y_lo + y_hi)
+        positive = _colebrook_residual(y_mid, a, b) > 0.
+        y_hi = np.where(positive, y_mid, y_hi)
+        y_lo = np.where(positive, y_lo, y_mid)
+    return 0.5 * (y_lo + y_hi)
+
+
+def poiseulle_colebrook(Re, D, eps_rough, bi_sectional_search=False,
+                        n_newton=5, tol=1e-10):
     """
     Friction factor of straight pipe
 
     Args:
-        Re (float):
+        Re (float or array of float):
             Reynolds number
 
-        D (float):
+        D (float or array of float):
             inner pipe diameter [m]
 
-        eps_rough (float):
+        eps_rough (float or array of float):
             inner pipe roughness [m]
 
         bi_sectional_search (bool, optional):
             if True then bisectional cut for root finding instead of
             Netwon-like method
 
-    Returns:
-        f (float):
-            friction factor after Poiseulle and Colebrook [/]
-    """
-    if Re <= REYNOLDS_PIPE_LAMINAR:
-        # Laminar: Poiseulle's law
-        return 64. / Re
-    else:
-        # Turbulent: Colebrook approximation
-        if bi_sectional_search:
-            assert 0, 'not implemented'
-        else:
-            a = eps_rough / (3.71 * D)
-            b = 2.51 / Re
+        n_newton (int, optional):
+            fixed number of Newton iterations
 
-            def equ(f):
-                one_over_2sqrt_f = 0.5 / sqrt(f)
-                return one_over_2sqrt_f + log10(a + b * one_over_2sqrt_f)
+        tol (float, optional):
+            elements with larger residual after Newton iterations are 
+            solved by bisectional cut
 
-            f = fsolve(equ, 0.02)
-            assert fabs(equ(f)) < 1.0e-5
+    Returns:
+        f (float or array of float):
+            friction factor after Poiseulle and Colebrook [/], 
+            float if all arguments are scalars; otherwise array of 
+            broadcast shape of arguments
+
+    Note:
+        The laminar/turbulent switch is applied per element.
+        Newton iterations are seeded by the explicit approximation of
+        Swamee and Jain
+    """
+    scalar = all(np.ndim(x) == 0 for x in (Re, D, eps_rough))
+    Re, D, eps_rough = np.broadcast_arrays(np.asfarray(Re), np.asfarray(D),
+                                           np.asfarray(eps_rough))
+    f = np.empty(Re.shape)
+
+    # Laminar: Poiseulle's law
+    laminar = Re <= REYNOLDS_PIPE_LAMINAR
+    with np.errstate(divide='ignore'):
+        f[laminar] = 64. / Re[laminar]
+
+    # Turbulent: Colebrook approximation
+    turbulent = ~laminar
+    if turbulent.any():
+        Re_t = Re[turbulent]
+        a = eps_rough[turbulent] / (3.71 * D[turbulent])
+        b = 2.51 / Re_t
 
-        return f[0]
+        if bi_sectional_search:
+            y = _colebrook_bisection(a, b)
+        else:
+            # seed: Swamee-Jain, f0 = 0.25 / log10(a + 5.74 / Re^0.9)^2 
+            y = -np.log10(a + 5.74 * Re_t**-0.9)
+            y = np.maximum(y, 1e-3)
+            ln10 = np.log(10.)
+            for it in range(n_newton):
+                y -= _colebrook_residual(y, a, b) / (1. + b / ((a + b * y) 
+                                                               * ln10))
+                y = np.maximum(y, 1e-3)
+                if telemetry.ACTIVE is not None:
+                    telemetry.iteration('poiseulle_colebrook', it, np.abs(
+                        _colebrook_residual(y, a, b)).max(), n=y.size)
+
+            # fallback for elements without convergence
+            failed = ~(np.abs(_colebrook_residual(y, a, b)) < tol)
+            if failed.any():
+                y[failed] = _colebrook_bisection(a[failed], b[failed])
+            telemetry.event('poiseulle_colebrook', 
+                            'bisection' if failed.any() else 'converged', 
+                            n_newton, n_failed=int(failed.sum()))
+
+        f[turbulent] = 0.25 / (y * y)
+
+    return float(f) if scalar else f
 
 
 def resistance_pipe(v, D, L=1.0, nu=1e-6, eps_rough=10e-6):
@@ -169,25 +255,24 @@ def _resistance_moderate_bend(v, D, r_bend, phi_bend_deg, nu, eps_rough):
         (float):
             resistance coefficient  [/]
     """
-    ratio = r_bend / D
-    assert ratio >= 1.8, 'not moderate bend'
+    scalar = _is_scalar(v, D, r_bend, phi_bend_deg, nu)
+    ratio = np.asfarray(r_bend) / D
+    assert np.all(ratio >= 1.8), 'not moderate bend'
 
-    alpha = 1.0
-    if ratio < 50.0:
-        if phi_bend_deg <= 45.0:
-            alpha = 1.0 + 5.13 * ratio**-1.47
-        elif phi_bend_deg <= 90.:
-            if ratio < 9.85:
-                alpha = 0.95 + 4.42 * ratio**-1.96
-        else:
-            alpha = 1.0 + 5.06 * ratio**-4.52
+    alpha = np.select(
+        [ratio >= 50.0, phi_bend_deg <= 45.0, phi_bend_deg <= 90.],
+        [1.0, 1.0 + 5.13 * ratio**-1.47, 
+         np.where(ratio < 9.85, 0.95 + 4.42 * ratio**-1.96, 1.0)],
+        1.0 + 5.06 * ratio**-4.52)
 
     Re = v * D / nu
-    if Re / ratio**2 <= 360.:
+    with np.errstate(divide='ignore'):
         fC = 0.336 * (Re * np.sqrt(ratio))**-0.2
-        return 0.0175 * alpha * fC * phi_bend_deg * ratio
-    else:
-        return 0.00431 * alpha * phi_bend_deg * Re**-0.17 * ratio**0.84
+        k = np.where(Re / ratio**2 <= 360.,
+                     0.0175 * alpha * fC * phi_bend_deg * ratio,
+                     0.00431 * alpha * phi_bend_deg * Re**-0.17 * 
+                     ratio**0.84)
+    return _out(k, scalar)
 
 
 def _resistance_sharp_bend(v, D, r_bend, phi_bend_deg, nu, eps_rough):
@@ -217,51 +302,33 @@ def _resistance_sharp_bend(v, D, r_bend, phi_bend_deg, nu, eps_rough):
         (float):
             resistance coefficient  [/]
     """
+    scalar = _is_scalar(v, D, r_bend, phi_bend_deg, nu)
     Re = v * D / nu
-    x = r_bend / D         # example: x(D=80mm, r_bend=112.5mm) = 2.81
+    x = np.asfarray(r_bend) / D  # example: x(D=80mm, r_bend=112.5mm) = 2.81
 
-    if x >= 1.8:
+    if np.any(x >= 1.8):
         print("??? function called with x: '" + str(x) + "'")
-
-    if phi_bend_deg < 20.:
-        if   x <= 0.5:  K = 0.053
-        elif x <= 0.75: K = 0.038
-        elif x <= 1.0:  K = 0.035
-        elif x <= 1.5:  K = 0.040
-        else:           K = 0.045
-    elif phi_bend_deg <= 30.:
-        if   x <= 0.5:  K = 0.12
-        elif x <= 0.75: K = 0.070
-        elif x <= 1.0:  K = 0.058
-        elif x <= 1.5:  K = 0.060
-        else:           K = 0.065
-    elif phi_bend_deg <= 45.:
-        if   x <= 0.5:  K = 0.27
-        elif x <= 0.75: K = 0.14
-        elif x <= 1.0:  K = 0.10
-        elif x <= 1.5:  K = 0.090
-        else:           K = 0.089
-    elif phi_bend_deg <= 75.:
-        if   x <= 0.5:  K = 0.80
-        elif x <= 0.75: K = 0.31
-        elif x <= 1.0:  K = 0.20
-        elif x <= 1.5:  K = 0.15
-        else:           K = 0.14
-    elif phi_bend_deg <= 90.:
-        if   x <= 0.5:  K = 1.1
-        elif x <= 0.75: K = 0.40
-        elif x <= 1.0:  K = 0.25
-        elif x <= 1.5:  K = 0.18
-        else:           K = 0.16
-    else:
-        assert x > 0.5, 'Invalid configuration'
-        # if   x <= 0.75: K = 0.70
-        # elif x <= 1.0:  K = 0.28
-        # elif x <= 1.5:  K = 0.21
-
-    if Re < 5e5:
-        K *= (5e5 / Re)**0.17
-    return K
+    assert np.all((phi_bend_deg <= 90.) | (x > 0.5)), 'Invalid configuration'
+
+    # K[i_phi, i_x]: rows phi < 20, <= 30, <= 45, <= 75, <= 90 deg, 
+    #   columns x <= 0.5, <= 0.75, <= 1.0, <= 1.5, > 1.5
+    # phi > 90 deg is not tabulated: K = NaN
+    #   (x <= 0.75: K = 0.70, x <= 1.0: K = 0.28, x <= 1.5: K = 0.21)
+    K_table = np.array([[0.053, 0.038, 0.035, 0.040, 0.045],
+                        [0.12,  0.070, 0.058, 0.060, 0.065],
+                        [0.27,  0.14,  0.10,  0.090, 0.089],
+                        [0.80,  0.31,  0.20,  0.15,  0.14],
+                        [1.1,   0.40,  0.25,  0.18,  0.16],
+                        [np.nan] * 5])
+    phi = np.asfarray(phi_bend_deg)
+    i_phi = np.where(phi < 20., 0, 
+                     np.searchsorted([30., 45., 75., 90.], phi) + 1)
+    i_x = np.searchsorted([0.5, 0.75, 1.0, 1.5], x)
+    K = K_table[i_phi, i_x]
+
+    with np.errstate(divide='ignore'):
+        K = np.where(Re < 5e5, K * (5e5 / Re)**0.17, K)
+    return _out(K, scalar)
 
 
 def resistance_pipe_bend(v, D, r_bend, phi_bend_deg, nu=1e-6, eps_rough=10e-6):
@@ -291,12 +358,25 @@ def resistance_pipe_bend(v, D, r_bend, phi_bend_deg, nu=1e-6, eps_rough=10e-6):
         (float):
             resistance coefficient  [/]
     """
-    if r_bend / D >= 1.8:
-        return _resistance_moderate_bend(v, D, r_bend, phi_bend_deg, nu, 
-                                         eps_rough)
-    else:
-        return _resistance_sharp_bend(v, D, r_bend, phi_bend_deg, nu, 
-                                      eps_rough)
+    scalar = _is_scalar(v, D, r_bend, phi_bend_deg, nu, eps_rough)
+    if scalar:
+        if r_bend / D >= 1.8:
+            return _resistance_moderate_bend(v, D, r_bend, phi_bend_deg, nu, 
+                                             eps_rough)
+        else:
+            return _resistance_sharp_bend(v, D, r_bend, phi_bend_deg, nu, 
+                                          eps_rough)
+
+    # per element switch between moderate and sharp bend
+    args = np.broadcast_arrays(*[np.asfarray(x) for x in 
+                                 (v, D, r_bend, phi_bend_deg, nu, eps_rough)])
+    k = np.empty(args[0].shape)
+    moderate = args[2] / args[1] >= 1.8
+    if moderate.any():
+        k[moderate] = _resistance_moderate_bend(*[x[moderate] for x in args])
+    if not moderate.all():
+        k[~moderate] = _resistance_sharp_bend(*[x[~moderate] for x in args])
+    return k
 
 
 def resistance_square_pipe_reduction(v1, D1, D2, nu=1e-6, eps_rough=10e-6):
@@ -337,17 +417,21 @@ def resistance_square_pipe_reduction(v1, D1, D2, nu=1e-6, eps_rough=10e-6):
         Transition range is neglected
     """
 
+    scalar = _is_scalar(v1, D1, D2, nu, eps_rough)
+
     # correction of possibly confused inlet and outlet values
-    (d1, d2) = (D1, D2) if D1 > D2 else (D2, D1)
+    d1, d2 = np.maximum(D1, D2), np.minimum(D1, D2)
     Re1 = v1 * d1 / nu   # Reynolds number at inlet
-    if Re1 < REYNOLDS_PIPE_LAMINAR:
+    with np.errstate(divide='ignore'):
         # laminar
-        return (1.2 + 160 / Re1) * ((d1 / d2)**4 - 1)
-    else:
-        # turbulent
-        f1 = poiseulle_colebrook(Re=Re1, D=d1, eps_rough=eps_rough)
-        x = (d1 / d2)**2
-        return (0.6 + 0.48 * f1) * x * (x-1)
+        k_lam = (1.2 + 160 / Re1) * ((d1 / d2)**4 - 1)
+
+    # turbulent
+    f1 = poiseulle_colebrook(Re=Re1, D=d1, eps_rough=eps_rough)
+    x = (d1 / d2)**2
+    k_turb = (0.6 + 0.48 * f1) * x * (x-1)
+
+    return _out(np.where(Re1 < REYNOLDS_PIPE_LAMINAR, k_lam, k_turb), scalar)
 
 
 def resistance_tapered_pipe_reduction(v1, D1, D2, nu=1e-6, eps_rough=10e-6,
@@ -391,12 +475,10 @@ def resistance_tapered_pipe_reduction(v1, D1, D2, nu=1e-6, eps_rough=10e-6,
         2) use v1 for velocity in pressure drop calculations
 
     """
-    x = sin(0.5*radians(alpha_deg))
-    if alpha_deg < 45.:
-        x *= 1.6
-    else:
-        x = np.sqrt(x)
-    return x * resistance_square_pipe_reduction(v1, D1, D2, nu, eps_rough)
+    x = np.sin(0.5 * np.radians(alpha_deg))
+    x = np.where(np.less(alpha_deg, 45.), 1.6 * x, np.sqrt(x))
+    k = x * resistance_square_pipe_reduction(v1, D1, D2, nu, eps_rough)
+    return _out(k, _is_scalar(v1, D1, D2, nu, eps_rough, alpha_deg))
 
 
 def resistance_square_pipe_expansion(v1, D1, D2, nu=1e-6, eps_rough=10e-6):
@@ -433,17 +515,21 @@ def resistance_square_pipe_expansion(v1, D1, D2, nu=1e-6, eps_rough=10e-6):
     Note
         use v1 as velocity in pressure drop calculations
     """
+    scalar = _is_scalar(v1, D1, D2, nu, eps_rough)
+
     # correction of possibly confused inlet and outlet values
-    d1, d2 = (D1, D2) if D1 < D2 else (D2, D1)
+    d1, d2 = np.minimum(D1, D2), np.maximum(D1, D2)
 
     Re1 = v1 * d1 / nu   # Reynolds number at inlet
-    if Re1 < REYNOLDS_PIPE_LAMINAR:
-        # laminar
-        return 2 * (1 - (d1 / d2)**4)
-    else:
-        # turbulent
-        f1 = poiseulle_colebrook(Re=Re1, D=d1, eps_rough=eps_rough)
-        return (1 + 0.8 * f1) * (1 - (d1 / d2)**2)**2
+
+    # laminar
+    k_lam = 2 * (1 - (d1 / d2)**4)
+
+    # turbulent
+    f1 = poiseulle_colebrook(Re=Re1, D=d1, eps_rough=eps_rough)
+    k_turb = (1 + 0.8 * f1) * (1 - (d1 / d2)**2)**2
+
+    return _out(np.where(Re1 < REYNOLDS_PIPE_LAMINAR, k_lam, k_turb), scalar)
 
 
 def resistance_tapered_pipe_expansion(v1, D1, D2, nu=1e-6, eps_rough=10e-6,
@@ -484,11 +570,22 @@ def resistance_tapered_pipe_expansion(v1, D1, D2, nu=1e-6, eps_rough=10e-6,
     Note:
         Use v1 as velocity in pressure drop calculations
     """
-    if alpha_deg < 45.:
-        x = 2.6 * np.sin(0.5 * radians(alpha_deg))
-    else:
-        x = 1
-    return x * resistance_square_pipe_expansion(v1, D1, D2, nu, eps_rough)
+    x = np.where(np.less(alpha_deg, 45.), 
+                 2.6 * np.sin(0.5 * np.radians(alpha_deg)), 1.)
+    k = x * resistance_square_pipe_expansion(v1, D1, D2, nu, eps_rough)
+    return _out(k, _is_scalar(v1, D1, D2, nu, eps_rough, alpha_deg))
+
+
+def _dp_set(dp_set, scalar, zero):
+    """
+    Returns:
+        tuple of floats if 'scalar' is True, otherwise tuple of arrays of 
+        common broadcast shape with zeros at elements with zero velocity
+    """
+    if scalar:
+        return tuple(float(dp) for dp in dp_set)
+    return tuple(np.where(zero, 0., dp) 
+                 for dp in np.broadcast_arrays(*dp_set, zero)[:-1])
 
 
 def dp_in_red_mid_exp_out(v1, D1, L1, D2, L2, D3, L3, nu=1e-6, rho=1e3,
@@ -544,16 +641,25 @@ def dp_in_red_mid_exp_out(v1, D1, L1, D2, L2, D3, L3, nu=1e-6, rho=1e3,
             tuning parameters, see '# tuning' comment in source code below
 
     Returns:
-        (6-tuple of float):
+        (6-tuple of float or of array of float):
             (dp, dp1, dp12, dp2, dp23, dp3)
             total pressure drop and pressure drops over sections in figure [Pa]
+
+    Note:
+        All arguments can be arrays, they are broadcast together. 
+        Then the elements of the returned tuple are arrays of the 
+        broadcast shape; otherwise they are floats
     """
-    if np.abs(v1) < 1e-20:
+    pars = [v1, D1, L1, D2, L2, D3, L3, nu, rho, eps_rough]
+    scalar = _is_scalar(*pars)
+    if scalar and np.abs(v1) < 1e-20:
         return 0.
+    assert np.all((np.less(D2, D1)) & (np.less(D2, D3))), str((D1, D2, D3))
 
-    pars = [v1, D1, L1, D2, L2, D3, L3, nu, rho, eps_rough]
-    assert all([isinstance(x, (int, float, bool)) for x in pars])
-    assert D1 > D2 < D3, str((D1, D2, D3))
+    # elements with zero velocity are evaluated with v1=1, result is 0
+    zero = np.abs(v1) < 1e-20
+    if not scalar:
+        v1 = np.where(zero, 1., v1)
 
     v2 = v1 * (D1 / D2)**2
     v3 = v2 * (D2 / D3)**2
@@ -573,7 +679,7 @@ def dp_in_red_mid_exp_out(v1, D1, L1, D2, L2, D3, L3, nu=1e-6, rho=1e3,
     dp3 = pressure_drop(k3,   v3, rho)
     dpTotal = (dp1 + dp12 + dp2 + dp23 + dp3) * (c3)  # tuning
 
-    return dpTotal, dp1, dp12, dp2, dp23, dp3
+    return _dp_set((dpTotal, dp1, dp12, dp2, dp23, dp3), scalar, zero)
 
 
 def dp_tapered_in_red_mid_exp_out(v1, D1, L1, D2, L2, D3, L3,
@@ -636,16 +742,25 @@ def dp_tapered_in_red_mid_exp_out(v1, D1, L1, D2, L2, D3, L3,
             inner pipe roughness [m]
 
     Returns:
-        (6-tuple of float):
+        (6-tuple of float or of array of float):
             (dp, dp1, dp12, dp2, dp23, dp3)
             total pressure drop and pressure drops over sections in figure [Pa]
+
+    Note:
+        All arguments can be arrays, they are broadcast together. 
+        Then the elements of the returned tuple are arrays of the 
+        broadcast shape; otherwise they are floats
     """
-    if np.abs(v1) < 1e-20:
+    pars = [v1, D1, L1, alpha12, D2, L2, alpha23, D3, L3, nu, rho, eps_rough]
+    scalar = _is_scalar(*pars)
+    if scalar and np.abs(v1) < 1e-20:
         return 0.
+    assert np.all((np.less(D2, D1)) & (np.less(D2, D3))), str((D1, D2, D3))
 
-    pars = [v1, D1, L1, alpha12, D2, L2, alpha23, D3, L3, nu, rho, eps_rough]
-    assert all([isinstance(x, (int, float, bool)) for x in pars])
-    assert D1 > D2 and D2 < D3
+    # elements with zero velocity are evaluated with v1=1, result is 0
+    zero = np.abs(v1) < 1e-20
+    if not scalar:
+        v1 = np.where(zero, 1., v1)
 
     v2 = v1 * (D1 / D2)**2
     v3 = v2 * (D2 / D3)**2
@@ -668,4 +783,4 @@ def dp_tapered_in_red_mid_exp_out(v1, D1, L1, D2, L2, D3, L3,
     dp3 = pressure_drop(k3,   v3, rho)
     dpTotal = (dp1 + dp12 + dp2 + dp23 + dp3)
 
-    return dpTotal, dp1, dp12, dp2, dp23, dp3
+    return _dp_set((dpTotal, dp1, dp12, dp2, dp23, dp3), scalar, zero)
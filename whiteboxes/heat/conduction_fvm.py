@@ -0,0 +1,422 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+__all__ = ['conduction_fvm']
+
+from numba import jit, prange
+import numpy as np
+from scipy.sparse import csr_matrix
+from scipy.sparse.linalg import cg, LinearOperator, spilu, spsolve
+from time import perf_counter
+from typing import Any, Callable, Dict, List, Optional, Tuple, Union
+
+from whiteboxes.heat.poisson_fvm1_nonlin import _constant_conductivity
+from whiteboxes.mesh.face import Face
+from whiteboxes.mesh.partly_regular import PartlyRegularMesh
+from whiteboxes.tools import telemetry
+
+# boundary condition types, see conduction_fvm()
+BC_TYPES = ('dirichlet', 'neumann', 'convective')
+
+
+@jit(nopython=True, parallel=True, cache=True)
+def _csr_kernel(G0: np.ndarray, G1: np.ndarray, G2: np.ndarray,
+                indptr: np.ndarray, indices: np.ndarray,
+                data: np.ndarray) -> None:
+    """
+    Fills column indices and values of the CSR matrix of the 7-point
+    stencil in place. Row r = (i*m1 + j)*m2 + k is the inner cell
+    (i, j, k); Gd are the conductances of the faces normal to axis d,
+    boundary faces included. Slabs i are assembled in parallel threads
+
+    Note:
+        Columns of each row are written in ascending order, as required
+        by the canonical CSR format
+    """
+    m0, m1, m2 = G0.shape[0] - 1, G1.shape[1] - 1, G2.shape[2] - 1
+    s0 = m1 * m2
+    for i in prange(m0):
+        for j in range(m1):
+            for k in range(m2):
+                r = (i * m1 + j) * m2 + k
+                pos = indptr[r]
+                if i > 0:
+                    indices[pos], data[pos] = r - s0, -G0[i, j, k]
+                    pos += 1
+                if j > 0:
+                    indices[pos], data[pos] = r - m2, -G1[i, j, k]
+                    pos += 1
+                if k > 0:
+                    indices[pos], data[pos] = r - 1, -G2[i, j, k]
+                    pos += 1
+                indices[pos] = r
+                data[pos] = G0[i, j, k] + G0[i+1, j, k] + \
+                    G1[i, j, k] + G1[i, j+1, k] + G2[i, j, k] + G2[i, j, k+1]
+                pos += 1
+                if k < m2 - 1:
+                    indices[pos], data[pos] = r + 1, -G2[i, j, k+1]
+                    pos += 1
+                if j < m1 - 1:
+                    indices[pos], data[pos] = r + m2, -G1[i, j+1, k]
+                    pos += 1
+                if i < m0 - 1:
+                    indices[pos], data[pos] = r + s0, -G0[i+1, j, k]
+
+
+def _conductivity_function(conductivity: Any,
+                           p: float) -> Callable[[np.ndarray], np.ndarray]:
+    """
+    Returns:
+        vectorized function k(T) of 'conductivity', which is a number,
+        a Matter (its Property 'k' is used), a Property or a function
+        of T accepting arrays
+
+    Raises:
+        ValueError if conductivity is invalid at any temperature
+    """
+    conductivity = getattr(conductivity, 'k', conductivity)
+    k_const = _constant_conductivity(conductivity)
+    if k_const is not None:
+        return lambda T: np.full(np.shape(T), k_const)
+
+    def k_func(T: np.ndarray) -> np.ndarray:
+        if hasattr(conductivity, 'eval_batch'):
+            k = conductivity.eval_batch(T, p, 0.)[0]
+        else:
+            k = np.broadcast_to(np.asfarray(conductivity(T)), np.shape(T))
+        if not np.isfinite(k).all():
+            raise ValueError('conductivity invalid in temperature range: ' +
+                             str((np.min(T), np.max(T))))
+        return k
+
+    return k_func
+
+
+def _face_axis(face: Face, ndim: int) -> Tuple[int, int]:
+    """
+    Returns:
+        axis and side (0: lower, -1: upper boundary) of 'face'
+    """
+    axis = abs(face.value) - 1
+    assert 0 <= axis < ndim, str((face, ndim))
+    return axis, (0 if face.value < 0 else -1)
+
+
+def _cg(A: csr_matrix, b: np.ndarray, x0: np.ndarray,
+        M: Optional[LinearOperator], tol: float) -> Tuple[np.ndarray, int]:
+    """
+    Conjugate gradients, compatible with old and new SciPy tolerance
+    keyword
+    """
+    try:
+        return cg(A, b, x0=x0, M=M, rtol=tol, atol=0.)
+    except TypeError:
+        return cg(A, b, x0=x0, M=M, tol=tol, atol=0.)
+
+
+def conduction_fvm(mesh: PartlyRegularMesh,
+                   conductivity: Any,
+                   bc: Dict[Face, Tuple[Any, ...]],
+                   source: Union[float, np.ndarray,
+                                 Callable[[np.ndarray], np.ndarray]] = 0.,
+                   T: Optional[np.ndarray] = None,
+                   p: float = 101325.,
+                   solver: str = 'ilu-cg',
+                   tol: float = 1e-10,
+                   mse: float = 1e-8,
+                   max_it: int = 50,
+                   min_it: int = 1,
+                   omega: float = 1.,
+                   silent: bool = True) -> Dict[str, Any]:
+    """
+    Solves the steady heat conduction equation with finite volumes on
+    a 1D, 2D or 3D rectilinear grid
+
+        div[k(T) grad T] + S(T) = 0
+
+    - unknowns are the inner cell centers of 'mesh'; the zero-width
+      ghost cells of PartlyRegularMesh hold the boundary temperatures
+    - face conductivity is evaluated at the mean temperature of the
+      adjacent cells; temperature-dependent k(T) and source S(T) are
+      resolved by Picard iteration, constant k needs one iteration
+    - the symmetric matrix is stored in CSR format; its values are
+      assembled by a compiled kernel with multi-threaded loops over
+      slabs of cells (numba prange, OpenMP or TBB threading layer)
+
+    Args:
+        mesh:
+            rectilinear 1D, 2D or 3D mesh, 2D is per unit depth
+
+        conductivity:
+            Matter (its Property 'k' is used), Property, number or
+            function k(T) accepting arrays [W/m/K]
+
+        bc:
+            boundary conditions per face, unspecified faces are
+            adiabatic. Values are scalars or arrays of shape of the
+            inner cells of the face, e.g. (mesh.shape[1]-2, 
+            mesh.shape[2]-2) for Face.WEST in 3D
+                Face.WEST: ('dirichlet', T_b)             [K]
+                Face.EAST: ('neumann', q)                 [W/m2] into body
+                Face.NORTH: ('convective', alpha, T_inf)  [W/m2/K], [K]
+
+        source:
+            volumetric heat source [W/m3]: number, array of shape of
+            inner cells or function S(T) accepting arrays
+
+        T:
+            initial temperature of inner cells, default: mean of
+            Dirichlet and ambient temperatures
+
+        p:
+            pressure for evaluation of Property conductivity [Pa]
+
+        solver:
+            'ilu-cg': conjugate gradients with incomplete LU
+                preconditioner [default]
+            'cg': conjugate gradients without preconditioner
+            'direct': sparse LU decomposition
+
+        tol:
+            relative tolerance of iterative linear solver
+
+        mse:
+            stop Picard iteration, if mean square difference of
+            temperature is less than 'mse'
+
+        max_it:
+            maximum number of Picard iterations
+
+        min_it:
+            minimum number of Picard iterations
+
+        omega:
+            under-relaxation of Picard iteration
+
+        silent:
+            if False, then print progress of iteration
+
+    Returns:
+        Dictionary:
+            'T' (array of float of shape mesh.shape):
+                temperature at cell centers, boundary ghost cells hold
+                the face temperatures; corner ghost cells are copies
+                of their neighbors
+            'x' (list of 1D arrays of float):
+                cell center coordinates per axis
+            'Q' (dict of float):
+                heat flow into body per boundary face [W],
+                [W/m] in 2D
+            'hist_mse', 'hist_time' (list of float):
+                history of mean square difference and wall time [s]
+            'it' (int):
+                index of last iteration
+            'info' (int):
+                status of linear solver of last iteration, 0: success
+
+    Raises:
+        ValueError if conductivity is invalid
+    """
+    assert solver in ('ilu-cg', 'cg', 'direct'), str(solver)
+    assert isinstance(mesh, PartlyRegularMesh) and 1 <= mesh.ndim <= 3
+    for face, spec in bc.items():
+        assert spec[0] in BC_TYPES, str(spec)
+    assert any(spec[0] != 'neumann' for spec in bc.values()), \
+        'at least one dirichlet or convective boundary condition required'
+
+    # inner cells of mesh are padded to 3D with single cell of unit width
+    ndim = mesh.ndim
+    x = [np.asfarray(x_j) for x_j in mesh.x1d] + \
+        [np.array([-0.5, 0., 0.5])] * (3 - ndim)
+    dx = [np.asfarray(dx_j[1:-1]) for dx_j in mesh.dx1d] + \
+        [np.ones(1)] * (3 - ndim)
+    dc = [np.diff(x_j) for x_j in x]    # distances between centers
+    m = tuple(dx_j.size for dx_j in dx)
+    N = int(np.prod(m))
+    V = dx[0][:, None, None] * dx[1][None, :, None] * dx[2][None, None, :]
+    A = [np.multiply.outer(*[dx[d] for d in range(3) if d != j])
+         for j in range(3)]    # face areas normal to axis j
+
+    k_func = _conductivity_function(conductivity, p)
+    k_const = _constant_conductivity(getattr(conductivity, 'k',
+                                             conductivity)) is not None
+    s_func = source if callable(source) else None
+    S = None if callable(source) else np.broadcast_to(np.asfarray(source), m)
+
+    # boundary conditions as arrays of face shape, ghost temperatures
+    bcs: Dict[Face, Tuple[int, int, str, List[np.ndarray]]] = {}
+    T_b: Dict[Face, np.ndarray] = {}
+    T_guess = []
+    for face, spec in bc.items():
+        axis, side = _face_axis(face, ndim)
+        values = [np.broadcast_to(np.asfarray(v), A[axis].shape)
+                  for v in spec[1:]]
+        bcs[face] = (axis, side, spec[0], values)
+        if spec[0] != 'neumann':
+            T_guess.append(values[-1].mean())
+            T_b[face] = np.array(values[-1])
+    if T is None:
+        T = np.full(m, np.mean(T_guess))
+    else:
+        T = np.array(T, dtype=float).reshape(m)
+    for face, (axis, side, kind, values) in bcs.items():
+        if face not in T_b:
+            T_b[face] = np.array(np.moveaxis(T, axis, 0)[side])
+
+    # CSR pattern: diagonal and existing neighbors per row
+    I = np.ix_(*[np.arange(m_j) for m_j in m])
+    counts = np.ones(m, dtype=np.int64)
+    for j in range(3):
+        counts += (I[j] > 0).astype(np.int64) + (I[j] < m[j] - 1)
+    indptr = np.zeros(N + 1, dtype=np.int64)
+    np.cumsum(counts.ravel(), out=indptr[1:])
+    indices = np.empty(indptr[-1], dtype=np.int64)
+    data = np.empty(indptr[-1])
+
+    G = [np.zeros(tuple(m_d + (d == j) for d, m_d in enumerate(m)))
+         for j in range(3)]
+    if solver == 'ilu-cg' and N == 1:
+        solver = 'direct'
+
+    result: Dict[str, Any] = {'hist_mse': [], 'hist_time': []}
+    start = perf_counter()
+    for it in range(max_it):
+        # conductances of inner faces
+        b = V * (s_func(T) if s_func is not None else S)
+        for j in range(3):
+            if m[j] > 1:
+                Tj, Gj = np.moveaxis(T, j, 0), np.moveaxis(G[j], j, 0)
+                k_f = k_func(0.5 * (Tj[1:] + Tj[:-1]))
+                d = dc[j][1:-1].reshape((-1,) + (1,) * 2)
+                Gj[1:-1] = k_f * A[j] / d
+
+        # conductances and heat flows of boundary faces
+        k_bound = {}
+        for face, (axis, side, kind, values) in bcs.items():
+            T1 = np.moveaxis(T, axis, 0)[side]
+            Gb = np.moveaxis(G[axis], axis, 0)
+            bj = np.moveaxis(b, axis, 0)
+            d = dc[axis][side]
+            if kind == 'dirichlet':
+                k_b = k_func(0.5 * (T1 + values[0]))
+                Gb[side] = k_b * A[axis] / d
+                bj[side] += Gb[side] * values[0]
+            elif kind == 'convective':
+                alpha, T_inf = values
+                k_b = k_func(0.5 * (T1 + T_b[face]))
+                Gb[side] = A[axis] / (1. / alpha + d / k_b)
+                bj[side] += Gb[side] * T_inf
+            else:
+                Gb[side] = 0.
+                bj[side] += values[0] * A[axis]
+            k_bound[face] = k_b if kind != 'neumann' else None
+
+        _csr_kernel(*[np.ascontiguousarray(G_j) for G_j in G],
+                    indptr, indices, data)
+        K = csr_matrix((data, indices, indptr), shape=(N, N))
+
+        info = 0
+        if solver == 'direct':
+            T_new = spsolve(K.tocsc(), b.ravel())
+        else:
+            M = None
+            if solver == 'ilu-cg':
+                # natural ordering keeps factors of K nearly symmetric
+                ilu = spilu(K.tocsc(), drop_tol=1e-5, fill_factor=10,
+                            permc_spec='NATURAL', diag_pivot_thresh=0.)
+                M = LinearOperator((N, N), ilu.solve)
+            T_new, info = _cg(K, b.ravel(), T.ravel(), M, tol)
+        T_new = T_new.reshape(m)
+
+        mse_ = float(np.mean(np.square(T_new - T)))
+        T = T * (1 - omega) + T_new * omega
+
+        # temperatures at boundary faces
+        for face, (axis, side, kind, values) in bcs.items():
+            T1 = np.moveaxis(T, axis, 0)[side]
+            d = dc[axis][side]
+            if kind == 'dirichlet':
+                T_b[face] = np.array(values[0])
+            elif kind == 'convective':
+                # heat flux through half cell equals convective flux
+                alpha, T_inf = values
+                T_b[face] = T1 + (T_inf - T1) / (1. + k_bound[face] /
+                                                 (alpha * d))
+            else:
+                T_b[face] = T1 + values[0] * d / k_func(T1)
+
+        result['hist_mse'].append(mse_)
+        result['hist_time'].append(perf_counter() - start)
+        telemetry.iteration('conduction_fvm', it, mse_, info=info, 
+                            solver=solver, n_cells=N)
+        if not silent:
+            print('+++ it:', it, 'mse:', mse_, 'info:', info)
+        if (k_const and s_func is None) or (mse_ < mse and it >= min_it):
+            telemetry.event('conduction_fvm', 'converged', it, mse_)
+            break
+    else:
+        telemetry.event('conduction_fvm', 'max_it', it, mse_)
+
+    # heat flow into body per face
+    Q = {}
+    for face, (axis, side, kind, values) in bcs.items():
+        T1 = np.moveaxis(T, axis, 0)[side]
+        Gb = np.moveaxis(G[axis], axis, 0)[side]
+        if kind == 'dirichlet':
+            Q[face] = float(np.sum(Gb * (values[0] - T1)))
+        elif kind == 'convective':
+            Q[face] = float(np.sum(Gb * (values[1] - T1)))
+        else:
+            Q[face] = float(np.sum(values[0] * A[axis]))
+
+    # inner cells and ghost cells of original dimension
+    T_out = np.pad(T.reshape(m[:ndim]), 1, mode='edge')
+    for face, (axis, side, kind, values) in bcs.items():
+        index: List[Union[int, slice]] = [slice(1, -1)] * ndim
+        index[axis] = side
+        T_out[tuple(index)] = T_b[face].reshape(m[:axis] + m[axis+1:ndim])
+
+    result['T'] = T_out
+    result['x'] = x[:ndim]
+    result['Q'] = Q
+    result['it'] = it
+    result['info'] = info
+
+    return result
+
+
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    ALL = 1
+
+    if 0 or ALL:
+        # 2D fin root at west, convection at north, south and east
+        mesh = PartlyRegularMesh((51, 11), (0., 0.05), (0., 0.005),
+                                 dtype=np.float64)
+        res = conduction_fvm(mesh, lambda T: 200. - 0.05 * (T - 300.),
+            bc={Face.WEST: ('dirichlet', 400.),
+                Face.EAST: ('convective', 20., 300.),
+                Face.NORTH: ('convective', 20., 300.),
+                Face.SOUTH: ('convective', 20., 300.)}, silent=False)
+        print('T_tip:', res['T'][-1, 5], 'Q:', res['Q'])
@@ -21,9 +21,14 @@
 """
 
 import matplotlib.pyplot as plt
-from numba import autojit
+from numba import jit, prange
 import numpy as np
 from tempfile import gettempdir
+from typing import Any, Dict, Iterable, Optional
+
+from whiteboxes.matter.conversion import C2K
+from whiteboxes.numerics.tdma import tdma_inplace
+from whiteboxes.tools import telemetry
 
 
 """
@@ -88,13 +93,19 @@ from tempfile import gettempdir
         differences. Discretisation for both cylindrical and Cartesian
         coordinates.
 
+        Alternatively implicit Euler or Crank-Nicolson time discretisation 
+        with a tridiagonal solve per time step. These schemes are 
+        unconditionally stable, the time step size is adapted to the 
+        change of the wall temperature per time step.
+
     Note:
-        Function temperature_in_wall_for_actual_time_step() is compiled 
-        just-in-time with the @autojit decorator.
+        Functions temperature_in_wall_for_actual_time_step() and
+        temperature_in_wall_for_theta_time_step() are compiled 
+        just-in-time with the @jit decorator.
 """
 
 
-@autojit
+@jit(nopython=True, cache=True)
 def temperature_in_wall_for_actual_time_step(X, T, T_old, Fo, alpha_in, \
         alpha_out, T_in, T_out, lambda_wal, is_cylinder):
     """
@@ -136,7 +147,7 @@ def temperature_in_wall_for_actual_time_step(X, T, T_old, Fo, alpha_in, \
         The implementation as a pre-compiled external function increases the
         execution speed. Example:
             foo(nx=200, v=10, T_in=10000, T_out=0, alpha_out=5)
-        --> speed up of 84 in comparison to speed without decorator '@autojit'
+        --> speed up of 84 in comparison to speed without decorator '@jit'
     """
     # space step size
     dx = X[1] - X[0]
@@ -171,6 +182,309 @@ def temperature_in_wall_for_actual_time_step(X, T, T_old, Fo, alpha_in, \
     T[-1] = T[-2] + q_dot_out * dx / lambda_wal
 
 
+@jit(nopython=True, cache=True)
+def temperature_in_wall_for_theta_time_step(X, T, T_old, Fo, theta, 
+        alpha_in, alpha_out, T_in, T_out, lambda_wal, is_cylinder, 
+        Lo, Di, Up, Rs, c):
+    """
+    Computes the temperature in the wall for the actual time step with 
+    the theta-scheme. This function is called from TransHeat1DPipe.task()
+
+        theta = 1:   implicit Euler
+        theta = 0.5: Crank-Nicolson
+
+    The Robin conditions at the nodes outside the wall are implicit:
+
+        T[0] - T[1] = beta_in * (T_in - (T[0] + T[1]) / 2), 
+        beta_in = alpha_in * dx / lambda_wal
+
+    Args:
+        X, T_old, alpha_in, alpha_out, T_in, T_out, lambda_wal, is_cylinder:
+            see temperature_in_wall_for_actual_time_step()
+
+        T (1D array of float):
+            actual temperature [K]
+            -- will be modified
+
+        Fo (float):
+            Fourier number a * dt / dx^2 of actual time step [/]
+
+        theta (float):
+            implicitness of time discretisation, 0 <= theta <= 1 [/]
+
+        Lo, Di, Up, Rs, c (1D arrays of float):
+            work arrays of tridiagonal system and of its solution, 
+            size of X
+            -- will be modified
+    """
+    # space step size
+    dx = X[1] - X[0]
+
+    for i in range(1, X.size-1):
+        if not is_cylinder:
+            c_e, c_w = 1., 1.
+        else:
+            c_e = 0.5 * (X[i+1] + X[i]) / X[i]
+            c_w = 0.5 * (X[i] + X[i-1]) / X[i]
+        lap = c_e * (T_old[i+1] - T_old[i]) - c_w * (T_old[i] - T_old[i-1])
+        Lo[i] = -theta * Fo * c_w
+        Up[i] = -theta * Fo * c_e
+        Di[i] = 1. + theta * Fo * (c_e + c_w)
+        Rs[i] = T_old[i] + (1. - theta) * Fo * lap
+
+    # Robin conditions at inner and outer surface
+    beta_in = alpha_in * dx / lambda_wal
+    beta_out = alpha_out * dx / lambda_wal
+    Di[0] = 1. + 0.5 * beta_in
+    Up[0] = -1. + 0.5 * beta_in
+    Rs[0] = beta_in * T_in
+    Lo[-1] = -1. + 0.5 * beta_out
+    Di[-1] = 1. + 0.5 * beta_out
+    Rs[-1] = beta_out * T_out
+
+    tdma_inplace(Lo, Di, Up, Rs, c, T)
+
+
+@jit(nopython=True, cache=True)
+def time_loop(X, T, T_old, dt, theta, adaptive, dT_step, a_wal, alpha_in, 
+              alpha_out, T_in, T_out, lambda_wal, is_cylinder, delta_T_wal, 
+              t_max, i_t_max, snap_every, snap_times, t_snap, T_snap):
+    """
+    Complete compiled time loop of TransHeat1DPipe without return to 
+    Python. Work arrays are allocated once before the loop, the time
+    steps do not allocate memory
+
+    Args:
+        X, alpha_in, alpha_out, T_in, T_out, lambda_wal, is_cylinder:
+            see temperature_in_wall_for_actual_time_step()
+
+        T (1D array of float):
+            initial temperature [K]
+            -- will be modified, contains final temperature
+
+        T_old (1D array of float):
+            work array, size of X
+
+        dt (float):
+            (initial) time step size [s]
+
+        theta (float):
+            theta < 0: explicit, 1: implicit Euler, 0.5: Crank-Nicolson
+
+        adaptive (bool):
+            if True, the time step of implicit schemes is adapted to 
+            the target temperature change 'dT_step' [K], 
+            see TransHeat1DPipe.task_theta()
+
+        a_wal (float):
+            thermal diffusivity of wall [m2/s]
+
+        delta_T_wal, t_max, i_t_max:
+            stopping criterion and limits of time and number of steps
+
+        snap_every (int):
+            temperature is recorded every 'snap_every' steps, 0: never
+
+        snap_times (1D array of float):
+            sorted times of additional (interpolated) records [s]
+
+        t_snap (1D array of float):
+            times of records
+            -- will be modified
+
+        T_snap (2D array of float):
+            preallocated buffer of records, shape: (capacity, X.size);
+            recording stops if buffer is full
+            -- will be modified
+
+    Returns:
+        t_end (float):
+            end time [s], -1 if a limit was exceeded
+        i_t (int):
+            number of time steps
+        n_snap (int):
+            number of records
+        status (int):
+            0: success, 1: time > t_max, 2: steps > i_t_max
+    """
+    n = X.size
+    dx = X[1] - X[0]
+    Lo, Di, Up, Rs = np.zeros(n), np.zeros(n), np.zeros(n), np.zeros(n)
+    c = np.zeros(n)
+    capacity = T_snap.shape[0]
+
+    t, i_t, n_snap, j_time = 0., 0, 0, 0
+    dt_min = dt * 1e-3
+    error_prv = abs(T[-1] - T_in)
+    while True:
+        T_old[:] = T
+        Fo = dt * a_wal / dx**2
+        if theta < 0.:
+            temperature_in_wall_for_actual_time_step(X, T, T_old, Fo, 
+                alpha_in, alpha_out, T_in, T_out, lambda_wal, is_cylinder)
+        else:
+            temperature_in_wall_for_theta_time_step(X, T, T_old, Fo, theta,
+                alpha_in, alpha_out, T_in, T_out, lambda_wal, is_cylinder, 
+                Lo, Di, Up, Rs, c)
+
+        dT_max = 0.
+        for i in range(1, n-1):
+            dT_max = max(dT_max, abs(T[i] - T_old[i]))
+        if theta >= 0. and adaptive and dT_max > 2 * dT_step and \
+                dt > dt_min:
+            # rejects step
+            T[:] = T_old
+            dt *= 0.5
+            continue
+        t_new = t + dt
+
+        # records interpolated temperatures at requested times
+        while j_time < snap_times.size and snap_times[j_time] <= t_new \
+                and n_snap < capacity:
+            w = min(max((snap_times[j_time] - t) / dt, 0.), 1.)
+            for i in range(n):
+                T_snap[n_snap, i] = T_old[i] + w * (T[i] - T_old[i])
+            t_snap[n_snap] = snap_times[j_time]
+            n_snap += 1
+            j_time += 1
+
+        i_t += 1
+        if snap_every > 0 and i_t % snap_every == 0 and n_snap < capacity:
+            T_snap[n_snap, :] = T
+            t_snap[n_snap] = t_new
+            n_snap += 1
+
+        error = abs(T[-1] - T_in)
+        if error < delta_T_wal:
+            if error_prv > error:
+                t_end = t + dt * (error_prv - delta_T_wal) / (error_prv - 
+                                                              error)
+            else:
+                t_end = t_new
+            return t_end, i_t, n_snap, 0
+        t = t_new
+        error_prv = error
+
+        if t > t_max:
+            return -1., i_t, n_snap, 1
+        if i_t_max > 0 and i_t > i_t_max:
+            return -1., i_t, n_snap, 2
+
+        if theta >= 0. and adaptive:
+            dt *= min(max(dT_step / max(dT_max, 1e-12), 0.5), 2.)
+
+
+@jit(nopython=True, parallel=True, cache=True)
+def time_loop_batch(X, T, dt, theta, adaptive, dT_step, a_wal, alpha_in, 
+                    alpha_out, T_in, T_out, lambda_wal, is_cylinder, 
+                    delta_T_wal, t_max, i_t_max, snap_every, snap_times, 
+                    t_snap, T_snap, t_end, steps, n_snap, status):
+    """
+    Runs time_loop() for many pipe configurations in parallel threads
+
+    Configuration k is defined by row k of the 2D array T (initial 
+    temperature) and by element k of the 1D arrays dt, dT_step, a_wal, 
+    alpha_in, alpha_out, T_in, T_out, lambda_wal, delta_T_wal, t_max 
+    and i_t_max.
+    Records of configuration k are stored in t_snap[k] and T_snap[k]. 
+    The results are stored in t_end[k], steps[k], n_snap[k] and 
+    status[k], see time_loop()
+    """
+    for k in prange(T.shape[0]):
+        T_old = np.empty(X.size)
+        t_end[k], steps[k], n_snap[k], status[k] = time_loop(X, T[k], 
+            T_old, dt[k], theta, adaptive, dT_step[k], a_wal[k], 
+            alpha_in[k], alpha_out[k], T_in[k], T_out[k], lambda_wal[k], 
+            is_cylinder, delta_T_wal[k], t_max[k], i_t_max[k], snap_every,
+            snap_times, t_snap[k], T_snap[k])
+
+
+def _theta_of_scheme(scheme: str) -> float:
+    return {'explicit': -1., 'implicit': 1., 'crank-nicolson': 0.5}[scheme]
+
+
+def _snap_buffer(n_configs: int, nx: int, snap_every: int, 
+                 snap_times: Optional[Iterable[float]], 
+                 n_snap_max: Optional[int]):
+    snap_times = np.sort(np.atleast_1d(np.asfarray(snap_times 
+        if snap_times is not None else [])))
+    if n_snap_max is None:
+        n_snap_max = snap_times.size + (1000 if snap_every > 0 else 0)
+    t_snap = np.full((n_configs, n_snap_max), np.nan)
+    T_snap = np.full((n_configs, n_snap_max, nx + 2), np.nan)
+    return snap_times, t_snap, T_snap
+
+
+def run_pipe_batch(configs: Iterable[Dict[str, Any]], 
+                   snap_every: int = 0,
+                   snap_times: Optional[Iterable[float]] = None,
+                   n_snap_max: Optional[int] = None,
+                   **kwargs: Any) -> Dict[str, np.ndarray]:
+    """
+    Runs many pipe configurations concurrently in compiled code
+
+    Args:
+        configs:
+            sequence of keyword dictionaries for TransHeat1DPipe, e.g.
+            [{'v': 3, 'alpha_out': 5, 'T_in': 100}, ...]. 
+            Mesh parameters (nx, D, thickness) and scheme must be 
+            identical, the limits t_max and i_t_max may differ
+
+        snap_every:
+            temperature is recorded every 'snap_every' steps, 0: never
+
+        snap_times:
+            times of additional (interpolated) records [s]
+
+        n_snap_max:
+            capacity of record buffer per configuration
+
+        kwargs:
+            keyword arguments common to all configurations, 
+            e.g. scheme='implicit'
+
+    Returns:
+        dictionary of arrays; index k of first dimension is configuration:
+            'X': coordinates [m]
+            't_end': end times [s], -1 if limit exceeded
+            'steps': number of time steps
+            'status': 0: success, 1: time > t_max, 2: steps > i_t_max
+            'n_snap': number of records
+            't_snap': times of records, NaN beyond n_snap [s]
+            'T_snap': recorded temperatures, NaN beyond n_snap [K]
+            'T': final temperatures [K]
+    """
+    pipes = []
+    for config in configs:
+        pipe = TransHeat1DPipe()
+        pipe.pre(**{**kwargs, **config, 'plot': False, 'silent': True})
+        pipes.append(pipe)
+    X = pipes[0].X
+    for pipe in pipes:
+        assert pipe.X.shape == X.shape and np.allclose(pipe.X, X) and \
+            pipe.scheme == pipes[0].scheme, 'mesh and scheme must be equal'
+    n = len(pipes)
+
+    snap_times, t_snap, T_snap = _snap_buffer(n, X.size - 2, snap_every, 
+                                              snap_times, n_snap_max)
+    par = lambda key: np.array([getattr(p, key) for p in pipes], dtype=float)
+    T = np.array([p.T for p in pipes])
+    t_end, steps = np.zeros(n), np.zeros(n, dtype=np.int64)
+    n_snap, status = np.zeros(n, dtype=np.int64), np.zeros(n, dtype=np.int64)
+
+    time_loop_batch(X, T, par('dt'), _theta_of_scheme(pipes[0].scheme), 
+                    bool(pipes[0].adaptive), par('dT_step'), par('a_wal'), 
+                    par('alpha_in'), par('alpha_out'), par('T_in'), 
+                    par('T_out'), par('lambda_wal'), 
+                    bool(pipes[0].isCylinder), par('delta_T_wal'), 
+                    par('t_max'), np.array([int(p.i_t_max or 0) for p in 
+                                            pipes], dtype=np.int64), 
+                    int(snap_every), snap_times, t_snap, T_snap, t_end, steps, n_snap, status)
+
+    return {'X': X, 't_end': t_end, 'steps': steps, 'status': status, 
+            'n_snap': n_snap, 't_snap': t_snap, 'T_snap': T_snap, 'T': T}
+
+
 class TransHeat1DPipe(object):
     def __init__(self, identifier='TransHeat1DPipe'):
         self.identifier = identifier
@@ -185,7 +499,7 @@ class TransHeat1DPipe(object):
                 line style of temperature curves, '-': solid, '--': dashed,
                 'r-o': red+points, ...
         """
-        if self.show and self.i_t % self.show == 0:
+        if self.plot and self.show and self.i_t % self.show == 0:
             self.show *= 2
             xw, xe, Tw, Te = self.X[0], self.X[-1], self.T[0], self.T[-1]
             self.X[0] = (self.X[0] + self.X[1]) * 0.5
@@ -204,6 +518,8 @@ class TransHeat1DPipe(object):
                 keyword arguments
         """
         # common
+        self.plot         = kwargs.get('plot',         True)
+        self.silent       = kwargs.get('silent',       False)
         self.show         = kwargs.get('show',         1)
         figsize           = kwargs.get('figsize',      (10, 8))
         self.save         = kwargs.get('save',         False)
@@ -229,6 +545,15 @@ class TransHeat1DPipe(object):
         rho_wal           = kwargs.get('rho_wal',      8000.)
         cp_wal            = kwargs.get('cp_wal',       500.)
         self.lambda_wal   = kwargs.get('lambda_wal',   15.)
+        wall              = kwargs.get('wall',         None)
+                                    # Matter of wall, e.g. St1_4301()
+        if wall is not None:
+            # constant solid properties are plain numbers, others are
+            # evaluated at initial wall temperature [K]
+            T_wal = C2K(self.T0)
+            rho_wal = wall.rho.to_number(T_wal)
+            cp_wal = wall.c_p.to_number(T_wal)
+            self.lambda_wal = wall.k.to_number(T_wal)
 
         # heat transfer in aurrounding gas
         self.alpha_out    = kwargs.get('alpha_out',    5.)
@@ -240,7 +565,15 @@ class TransHeat1DPipe(object):
         self.t_max        = kwargs.get('t_max',        1000.)
         self.i_t_max      = kwargs.get('i_t_max',      round(1e12))
                                                             # stop criterion
-        a_wal = self.lambda_wal / (rho_wal * cp_wal)        # thermal diffusity
+        self.scheme       = kwargs.get('scheme',       'explicit')
+                                    # 'explicit', 'implicit', 'crank-nicolson'
+        self.adaptive     = kwargs.get('adaptive',     True)
+        self.dT_step      = kwargs.get('dT_step',      self.delta_T_wal)
+                                    # target of temperature change per step
+        assert self.scheme in ('explicit', 'implicit', 'crank-nicolson'), \
+            str(self.scheme)
+        self.a_wal = self.lambda_wal / (rho_wal * cp_wal)   # thermal diffusity
+        a_wal = self.a_wal
         self.x_in = D * 0.5                                 # inner radius
         self.x_out = self.x_in + thickness                  # outer radius
 
@@ -252,23 +585,27 @@ class TransHeat1DPipe(object):
         self.alpha_in = Nu_in * lambda_in / D       # inner heat transfer coeff
 
         self.dx = (self.x_out - self.x_in) / self.nx        # space step size
-        self.dt = self.dx**2 / (2 * a_wal)
+        self.dt = kwargs.get('dt', self.dx**2 / (2 * a_wal))  # initial step
+        if self.scheme == 'explicit':
+            self.dt = min(self.dt, self.dx**2 / (2 * a_wal))  # stability
         self.Fo = self.dt * a_wal / self.dx**2
 
         # print local parameters
-        print('+++ Parameters:')
-        lst = dict(locals(), **self.__dict__)
-        for key in sorted(lst, key=lambda s: s.lower()):
-            if not key.startswith('_') and key not in \
-                ('program', 'save', 'fig', 'show', 'figsize', 'self', 'kwargs',
-                 'version', 'X', 'T', 'T_old'):
-                print('{:>15}: {}'.format(key, lst[key]))
-        print('')
+        if not self.silent:
+            print('+++ Parameters:')
+            lst = dict(locals(), **self.__dict__)
+            for key in sorted(lst, key=lambda s: s.lower()):
+                if not key.startswith('_') and key not in \
+                    ('program', 'save', 'fig', 'show', 'figsize', 'self', 
+                     'kwargs', 'version', 'X', 'T', 'T_old', 'work'):
+                    print('{:>15}: {}'.format(key, lst[key]))
+            print('')
 
         self.X = np.linspace(self.x_in - 0.5 * self.dx,
                              self.x_out + 0.5 * self.dx, self.nx+2)
         self.T = np.full(self.X.size, float(self.T0))
         self.T_old = np.copy(self.T)
+        self.work = [np.zeros(self.X.size) for _ in range(5)]  # Lo..Rs,c
 
         # check that center of boundary cells are at wall positions
         assert np.isclose(2*self.x_in, self.X[0]+self.X[1]), \
@@ -280,6 +617,9 @@ class TransHeat1DPipe(object):
         assert np.isclose(self.dx, self.X[-1]-self.X[-2]), \
             str(self.dx)+' '+str(self.X[-1])+' '+str(self.X[-2])
 
+        if not self.plot:
+            return
+
         # plot empty diagram with settings for x and T
         self.fig = plt.figure(figsize=figsize)
         plt.xlim(self.x_in * 1e3, self.x_out * 1e3)
@@ -298,6 +638,8 @@ class TransHeat1DPipe(object):
         """
         self.t = 0.
         self.i_t = 0
+        if self.scheme != 'explicit':
+            return self.task_theta(**kwargs)
         while True:
 
             # swap old and actual temperature array
@@ -310,25 +652,165 @@ class TransHeat1DPipe(object):
                 self.X, self.T, self.T_old, self.Fo, self.alpha_in,
                 self.alpha_out, self.T_in, self.T_out, self.lambda_wal,
                 self.isCylinder)
-            if self.i_t > 0 and np.abs(self.T[-1] -
-                                       self.T_in) < self.delta_T_wal:
+            error = np.abs(self.T[-1] - self.T_in)
+            telemetry.iteration(self.identifier, self.i_t, error, t=self.t)
+            if self.i_t > 0 and error < self.delta_T_wal:
                 self.plot_single_time_step()
                 # plota final wall temperature distribution
                 print('+++ t_end: ', self.t, ' (', self.i_t, ' steps)')
                 self.plot_single_time_step('r-o')
+                telemetry.event(self.identifier, 'converged', self.i_t, 
+                                error, t=self.t)
                 return self.t
 
             if self.t > self.t_max:
                 print('\n??? Break: physical time > limit: ', self.t_max)
+                telemetry.event(self.identifier, 't_max', self.i_t, error, 
+                                t=self.t)
                 return -1.0
 
             if self.i_t_max and self.i_t > self.i_t_max:
                 print('\n??? Break: steps > limit: ', self.i_t_max)
+                telemetry.event(self.identifier, 'i_t_max', self.i_t, error, 
+                                t=self.t)
                 return -1.0
 
             self.t += self.dt
             self.i_t += 1
 
+    def task_theta(self, **kwargs):
+        """
+        Performs task with implicit Euler or Crank-Nicolson scheme, this 
+        method is called from task()
+
+        If self.adaptive is True, the time step size is controlled by 
+        the maximum temperature change per step: dt is multiplied by 
+        dT_step/max|T-T_old| (limited to [0.5, 2]); a step with a change 
+        larger than 2*dT_step is repeated with half step size. 
+        The end time is interpolated linearly between the two steps 
+        enclosing the crossing of the stopping criterion 
+
+        Args:
+            kwargs (dict, optional):
+                keyword arguments
+
+        Returns:
+            end time [s]
+            OR
+            -1. if limit of time or number of steps is exceeded
+        """
+        theta = 1. if self.scheme == 'implicit' else 0.5
+        dt_min = self.dt * 1e-3
+        Lo, Di, Up, Rs, c = self.work
+        error_prv = np.abs(self.T[-1] - self.T_in)
+        while True:
+
+            # swap old and actual temperature array
+            self.T, self.T_old = self.T_old, self.T
+
+            self.plot_single_time_step('--')
+
+            # computes actual wall temperature
+            self.Fo = self.dt * self.a_wal / self.dx**2
+            temperature_in_wall_for_theta_time_step(
+                self.X, self.T, self.T_old, self.Fo, theta, self.alpha_in,
+                self.alpha_out, self.T_in, self.T_out, self.lambda_wal,
+                self.isCylinder, Lo, Di, Up, Rs, c)
+
+            dT_max = np.abs(self.T[1:-1] - self.T_old[1:-1]).max()
+            if self.adaptive and dT_max > 2 * self.dT_step and \
+                    self.dt > dt_min:
+                # rejects step, T_old is unchanged
+                self.T, self.T_old = self.T_old, self.T
+                self.dt *= 0.5
+                continue
+
+            error = np.abs(self.T[-1] - self.T_in)
+            telemetry.iteration(self.identifier, self.i_t, error, t=self.t, 
+                                dt=self.dt)
+            if error < self.delta_T_wal:
+                if error_prv > error:
+                    self.t += self.dt * (error_prv - self.delta_T_wal) / \
+                        (error_prv - error)
+                else:
+                    self.t += self.dt
+                self.i_t += 1
+                print('+++ t_end: ', self.t, ' (', self.i_t, ' steps)')
+                self.plot_single_time_step('r-o')
+                telemetry.event(self.identifier, 'converged', self.i_t, 
+                                error, t=self.t)
+                return self.t
+
+            self.t += self.dt
+            self.i_t += 1
+            error_prv = error
+
+            if self.t > self.t_max:
+                print('\n??? Break: physical time > limit: ', self.t_max)
+                telemetry.event(self.identifier, 't_max', self.i_t, error, 
+                                t=self.t)
+                return -1.0
+
+            if self.i_t_max and self.i_t > self.i_t_max:
+                print('\n??? Break: steps > limit: ', self.i_t_max)
+                telemetry.event(self.identifier, 'i_t_max', self.i_t, error, 
+                                t=self.t)
+                return -1.0
+
+            if self.adaptive:
+                self.dt *= np.clip(self.dT_step / max(dT_max, 1e-12), 
+                                   0.5, 2.)
+
+    def run(self, snap_every: int = 0, 
+            snap_times: Optional[Iterable[float]] = None,
+            n_snap_max: Optional[int] = None, 
+            **kwargs: Any) -> Dict[str, Any]:
+        """
+        Headless run: pre-processing without plot and print, complete 
+        time loop in compiled code, see time_loop()
+
+        Args:
+            snap_every:
+                temperature is recorded every 'snap_every' steps, 0: never
+
+            snap_times:
+                times of additional (interpolated) records [s]
+
+            n_snap_max:
+                capacity of record buffer, default: number of snap_times
+                plus 1000 if snap_every > 0
+
+            kwargs:
+                keyword arguments, see pre()
+
+        Returns:
+            dictionary:
+                't_end': end time [s], -1 if limit exceeded
+                'steps': number of time steps
+                'status': 0: success, 1: time > t_max, 2: steps > i_t_max
+                't_snap': 1D array of record times [s]
+                'T_snap': 2D array of recorded temperatures [K], 
+                    shape: (len(t_snap), nx+2)
+        """
+        self.pre(**{**kwargs, 'plot': False, 'silent': True})
+        snap_times, t_snap, T_snap = _snap_buffer(1, self.nx, snap_every, 
+                                                  snap_times, n_snap_max)
+
+        t_end, self.i_t, n_snap, status = time_loop(self.X, self.T, 
+            self.T_old, self.dt, _theta_of_scheme(self.scheme), 
+            bool(self.adaptive), self.dT_step, self.a_wal, self.alpha_in, 
+            self.alpha_out, self.T_in, self.T_out, self.lambda_wal, 
+            bool(self.isCylinder), self.delta_T_wal, float(self.t_max), 
+            int(self.i_t_max or 0), int(snap_every), snap_times, t_snap[0], 
+            T_snap[0])
+        self.t = t_end
+        telemetry.event(self.identifier, 
+                        ('converged', 't_max', 'i_t_max')[status], self.i_t, 
+                        t=t_end, compiled=True)
+
+        return {'t_end': t_end, 'steps': self.i_t, 'status': status, 
+                't_snap': t_snap[0, :n_snap], 'T_snap': T_snap[0, :n_snap]}
+
     def post(self, **kwargs):
         """
         Performs post-processing, this method is called from __call__()
@@ -337,6 +819,8 @@ class TransHeat1DPipe(object):
             kwargs (dict, optional):
                 keyword arguments
         """
+        if not self.plot:
+            return
         plt.title('v : ' + str(self.v) + ' m/s ' +
                   r' $\alpha_{out}$ : ' + str(self.alpha_out) +
                   r' Wm$^{-2}$K$^{-1}$' +
@@ -361,8 +845,9 @@ class TransHeat1DPipe(object):
                 keyword arguments
         """
         self.pre(**kwargs)
-        self.task(**kwargs)
+        t_end = self.task(**kwargs)
         self.post(**kwargs)
+        return t_end
 
 
 # Examples ####################################################################
@@ -390,3 +875,18 @@ if __name__ == "__main__":
         plt.plot(t_nx.T[0], t_nx.T[1])
         plt.grid()
         plt.show()
+    if 0:
+        # Implicit schemes: step size set by accuracy instead of stability
+        for scheme in ['explicit', 'implicit', 'crank-nicolson']:
+            t_response = foo(nx=512, v=10, T_in=100, T_out=20, t_max=100,
+                             alpha_out=5, delta_T_wal=0.1, scheme=scheme,
+                             plot=False)
+            print('+++', scheme, 't_response:', t_response,
+                  'steps:', foo.i_t)
+    if 0:
+        # Headless runs of many configurations
+        res = run_pipe_batch([{'v': v, 'alpha_out': alpha_out, 'T_in': 100}
+                              for v in [1, 3, 10] for alpha_out in [5, 10]],
+                             snap_every=100, nx=128, T_out=20, t_max=100,
+                             delta_T_wal=0.1, scheme='implicit')
+        print('+++ t_end:', res['t_end'], 'steps:', res['steps'])
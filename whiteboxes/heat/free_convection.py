@@ -21,10 +21,34 @@
 """
 
 import numpy as np
-from typing import Optional
+from typing import Iterable, Optional, Tuple, Union
 
 from whiteboxes.matter.gases import Air
-from whiteboxes.matter.generic import Fluid
+from whiteboxes.matter.matter import Fluid
+
+# status codes of array evaluation, see FreeConvectionPlate.alpha_conv()
+CONV_OK = 0                 # correlation applied within its validity range
+CONV_EXTRAPOLATED = 1       # Rayleigh number outside of validity range
+CONV_INVALID_ANGLE = 2      # no correlation for plate angle, alpha is NaN
+CONV_NOT_HEATED = 3         # T_surf <= T_inf, alpha is NaN
+CONV_INVALID_LENGTH = 4     # L <= 0, alpha is NaN
+CONV_INVALID_FLUID = 5      # fluid properties invalid, alpha is NaN
+
+
+def _is_scalar(*args) -> bool:
+    """
+    Returns:
+        True if all arguments are scalars
+    """
+    return all(np.ndim(x) == 0 for x in args)
+
+
+def _out(y: np.ndarray, scalar: bool) -> Union[float, np.ndarray]:
+    """
+    Returns:
+        y as float if 'scalar' is True, otherwise y as array
+    """
+    return float(y) if scalar else np.asfarray(y)
 
 
 class FreeConvectionPlate(object):
@@ -71,6 +95,13 @@ class FreeConvectionPlate(object):
             foo.fluid = Air()
             foo.eps_rad = 0.95
             alpha = foo.alpha_conv_rad(T_surf, T_inf, L, phi_plate)
+
+        Note:
+            All arguments can be floats or arrays which broadcast
+            together, e.g. temperatures and orientations of many
+            surface panels. Methods return floats if all arguments are
+            floats. Fluid properties are evaluated once per call for all
+            elements at the film temperature
     """
 
     def __init__(self, fluid: Optional[Fluid] = None, 
@@ -99,8 +130,41 @@ class FreeConvectionPlate(object):
     def eps_rad(self, value: float) -> None:
         self._eps_rad = np.clip(value, 0, 1)
 
-    def alpha_conv(self, T_surf: float, T_inf: float, L: float, 
-                   phi_plate: float = 0.) -> float:
+    def film_properties(self, T_surf: Union[float, Iterable[float]], 
+                        T_inf: Union[float, Iterable[float]]) \
+            -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+        """
+        Evaluates fluid properties at film temperature in one batch
+
+        Args:
+            T_surf:
+                surface temperature [K]
+
+            T_inf:
+                fluid temperature outside film [K]
+
+        Returns:
+            film temperature T_film [K], thermal conductivity k [W/(m K)],
+            kinematic viscosity nu [m^2/s] and thermal diffusivity 
+            a [m^2/s] as arrays of broadcast shape; invalid elements are 
+            NaN
+        """
+        assert isinstance(self.fluid, Fluid)
+
+        T_film = 0.5 * (np.asfarray(T_surf) + np.asfarray(T_inf))
+        k, _ = self.fluid.k.eval_batch(T_film)
+        nu, _ = self.fluid.nu.eval_batch(T_film)
+        a, _ = self.fluid.a.eval_batch(T_film)
+
+        return T_film, k, nu, a
+
+    def alpha_conv(self, T_surf: Union[float, Iterable[float]], 
+                   T_inf: Union[float, Iterable[float]], 
+                   L: Union[float, Iterable[float]], 
+                   phi_plate: Union[float, Iterable[float]] = 0.,
+                   return_status: bool = False) \
+            -> Union[float, np.ndarray, Tuple[Union[float, np.ndarray],
+                                              Union[int, np.ndarray]]]:
         """
         Convective heat transfer coefficient for natural convection
 
@@ -122,8 +186,14 @@ class FreeConvectionPlate(object):
                 - phi = 180      deg : horizontal lower face of heated plate
                 - 30 <= phi < 90 deg : inclined face of heated plate
 
+            return_status:
+                if True, then status codes CONV_* are returned in addition
+
         Returns:
-            Convective heat transfer coefficient alpha_conv [W/(m^2 K)]
+            Convective heat transfer coefficient alpha_conv [W/(m^2 K)],
+            NaN for invalid plate angles, lengths or temperatures
+            OR
+            (alpha_conv, status) if return_status is True
 
            z ^
            |
@@ -132,20 +202,53 @@ class FreeConvectionPlate(object):
            +-====\=======----> x
            y         hot
         """
-        assert T_surf > T_inf
-
-        phi_plate = float(phi_plate)
-        if phi_plate == 0.:
-            return self.alpha_LUpper(T_surf, T_inf, L)
-        elif 30. <= phi_plate and phi_plate <= 90.:
-            return self.alpha_L_vert(T_surf, T_inf, L, np.abs(90. - phi_plate))
-        elif phi_plate == 180.:
-            return self.alpha_L_upper(T_surf, T_inf, L)
-        else:
-            print('??? invalid alpha_conv() phi_plate:', phi_plate)
-            return np.inf
-
-    def alpha_rad(self, T_surf: float, T_inf: float) -> float:
+        scalar = _is_scalar(T_surf, T_inf, L, phi_plate)
+        T_surf, T_inf, L, phi = np.broadcast_arrays(np.asfarray(T_surf),
+            np.asfarray(T_inf), np.asfarray(L), np.asfarray(phi_plate))
+
+        # orientation branch per element
+        upper = phi == 0.
+        vert = (30. <= phi) & (phi <= 90.)
+        lower = phi == 180.
+
+        status = np.full(phi.shape, CONV_OK, dtype=np.int8)
+        status[~(T_surf > T_inf)] = CONV_NOT_HEATED
+        status[~(L > 1e-20)] = CONV_INVALID_LENGTH
+        status[~(upper | vert | lower)] = CONV_INVALID_ANGLE
+
+        alpha = np.full(phi.shape, np.nan)
+        ok = status == CONV_OK
+        if ok.any():
+            Ts, Ti, L_ok = T_surf[ok], T_inf[ok], L[ok]
+            T_film, k, nu, a = self.film_properties(Ts, Ti)
+            theta = np.where(vert[ok], 90. - phi[ok], 0.)
+            Ra_L = self._rayleigh(Ts, Ti, L_ok, theta, T_film, nu, a)
+
+            up_ok, vert_ok, low_ok = upper[ok], vert[ok], lower[ok]
+            with np.errstate(invalid='ignore', divide='ignore'):
+                Nu = np.select([up_ok, vert_ok], 
+                               [self.nusselt_L_upper(Ra_L),
+                                self.nusselt_L_vert(Ra_L, nu / a)],
+                               self.nusselt_L_lower(Ra_L))
+                alpha_ok = Nu * k / L_ok
+
+                extrapolated = (up_ok & ((Ra_L < 1e4) | (Ra_L > 1e11))) | \
+                    (vert_ok & (Ra_L >= 1e30)) | \
+                    (low_ok & ((Ra_L < 1e5) | (Ra_L > 1e11)))
+            st_ok = np.where(extrapolated, CONV_EXTRAPOLATED, CONV_OK)
+            st_ok[~np.isfinite(alpha_ok)] = CONV_INVALID_FLUID
+            status[ok] = st_ok
+            alpha[ok] = np.where(st_ok == CONV_INVALID_FLUID, np.nan, 
+                                 alpha_ok)
+
+        if return_status:
+            return _out(alpha, scalar), \
+                (int(status) if scalar else status)
+        return _out(alpha, scalar)
+
+    def alpha_rad(self, T_surf: Union[float, Iterable[float]], 
+                  T_inf: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computes equivalent heat transfer coefficient for radiation
 
@@ -159,15 +262,25 @@ class FreeConvectionPlate(object):
         Returns:
             Equivalent radiative heat transfer coefficient
             alpha_rad [W/(m^2 K)]
+
+        Note:
+            (T_surf^4 - T_inf^4) / (T_surf - T_inf) is evaluated as
+            (T_surf^2 + T_inf^2) * (T_surf + T_inf), there is no 
+            singularity at T_surf = T_inf
         """
-        dT = T_surf - T_inf
-        if np.abs(dT) < 1e-20:
-            return 0
-        e = self.eps_rad * 5.67e-8 * (T_surf**4 - T_inf**4)
-        return e / dT
-
-    def alpha_combined(self, T_surf: float, T_inf: float, L: float, 
-                       phi_plate: float = 0.) -> float:
+        scalar = _is_scalar(T_surf, T_inf)
+        T_surf, T_inf = np.asfarray(T_surf), np.asfarray(T_inf)
+        alpha = self.eps_rad * 5.67e-8 * (T_surf**2 + T_inf**2) * \
+            (T_surf + T_inf)
+        return _out(alpha, scalar)
+
+    def alpha_combined(self, T_surf: Union[float, Iterable[float]], 
+                       T_inf: Union[float, Iterable[float]], 
+                       L: Union[float, Iterable[float]], 
+                       phi_plate: Union[float, Iterable[float]] = 0.,
+                       return_status: bool = False) \
+            -> Union[float, np.ndarray, Tuple[Union[float, np.ndarray],
+                                              Union[int, np.ndarray]]]:
         """
         Computes convective heat transfer coefficient for natural
         convection and radiation
@@ -190,9 +303,15 @@ class FreeConvectionPlate(object):
                 - phi=180    deg : horizontal lower face of heated plate
                 - 30<=phi<90 deg : inclined face of heated plate
 
+            return_status:
+                if True, then status codes CONV_* of the convective part
+                are returned in addition, see alpha_conv()
+
          Returns:
              Combined heat transfer coefficient alpha_eff
              considering convection and radiation [W/(m^2 K)]
+             OR
+             (alpha_eff, status) if return_status is True
 
         z ^
           |
@@ -201,11 +320,18 @@ class FreeConvectionPlate(object):
           +-====\=======----> x
          y        hot
         """
-        return self.alpha_conv(T_surf, T_inf, L, phi_plate) + \
-            self.alpha_rad(T_surf, T_inf)
-
-    def alpha_L_vert(self, T_surf: float, T_inf: float, L: float, 
-                     theta: float = 0.) -> float:
+        alpha, status = self.alpha_conv(T_surf, T_inf, L, phi_plate, 
+                                        return_status=True)
+        alpha = alpha + self.alpha_rad(T_surf, T_inf)
+        if return_status:
+            return alpha, status
+        return alpha
+
+    def alpha_L_vert(self, T_surf: Union[float, Iterable[float]], 
+                     T_inf: Union[float, Iterable[float]], 
+                     L: Union[float, Iterable[float]], 
+                     theta: Union[float, Iterable[float]] = 0.) \
+            -> Union[float, np.ndarray]:
         """
         Computes convective heat transfer coefficient for natural
         convection on vertical or inclined plates
@@ -236,16 +362,19 @@ class FreeConvectionPlate(object):
             Convective heat transfer coefficient alpha_conv [W/(m^2 K)]
 
         """
-        isinstance(self.fluid, Fluid)
-        assert L > 1e-20
-        assert 0 <= theta and theta <= 60
+        scalar = _is_scalar(T_surf, T_inf, L, theta)
+        assert np.all(np.asfarray(L) > 1e-20)
+        assert np.all((0 <= np.asfarray(theta)) & (np.asfarray(theta) <= 60))
 
-        T_film = 0.5 * (T_surf + T_inf)
-        Ra_L = self.rayleigh_L(T_surf, T_inf, L, theta)
+        T_film, k, nu, a = self.film_properties(T_surf, T_inf)
+        Ra_L = self._rayleigh(T_surf, T_inf, L, theta, T_film, nu, a)
 
-        return self.nusselt_L_vert(Ra_L, L) * self.fluid.lambda_(T_film) / L
+        return _out(self.nusselt_L_vert(Ra_L, nu / a) * k / L, scalar)
 
-    def alpha_L_upper(self, T_surf: float, T_inf: float, L: float) -> float:
+    def alpha_L_upper(self, T_surf: Union[float, Iterable[float]], 
+                      T_inf: Union[float, Iterable[float]], 
+                      L: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computes convective heat transfer coefficient for natural convection at
         the upper side of a HEATED horizontal plate T_surf > T_inf
@@ -267,15 +396,18 @@ class FreeConvectionPlate(object):
             This function is also applicable to upper COOLED plates with
             T_surf < T_inf
         """
-        assert isinstance(self.fluid, Fluid)
-        assert L > 1e-20
+        scalar = _is_scalar(T_surf, T_inf, L)
+        assert np.all(np.asfarray(L) > 1e-20)
 
-        T_film = 0.5 * (T_surf + T_inf)
-        Ra_L = self.rayleigh_L(T_surf, T_inf, L)
+        T_film, k, nu, a = self.film_properties(T_surf, T_inf)
+        Ra_L = self._rayleigh(T_surf, T_inf, L, 0., T_film, nu, a)
 
-        return self.nusselt_L_upper(Ra_L) * self.fluid.lambda_(T_film) / L
+        return _out(self.nusselt_L_upper(Ra_L) * k / L, scalar)
 
-    def alpha_L_lower(self, T_surf: float, T_inf: float, L: float) -> float:
+    def alpha_L_lower(self, T_surf: Union[float, Iterable[float]], 
+                      T_inf: Union[float, Iterable[float]], 
+                      L: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computes convective heat transfer coefficient for natural 
         convection at lower side of a HEATED horizontal plate where 
@@ -298,22 +430,24 @@ class FreeConvectionPlate(object):
             This function is also applicable to upper COOLED plates with
             T_surf < T_inf
         """
-        assert isinstance(self.fluid, Fluid)
-        assert L > 1e-20
+        scalar = _is_scalar(T_surf, T_inf, L)
+        assert np.all(np.asfarray(L) > 1e-20)
 
-        T_film = 0.5 * (T_surf + T_inf)
-        Ra_L = self.rayleigh_L(T_surf, T_inf, L)
+        T_film, k, nu, a = self.film_properties(T_surf, T_inf)
+        Ra_L = self._rayleigh(T_surf, T_inf, L, 0., T_film, nu, a)
 
-        return self.nusselt_L_lower(Ra_L) * self._fluid.lambda_(T_film) / L
+        return _out(self.nusselt_L_lower(Ra_L) * k / L, scalar)
 
-    def nusselt_L_vert(self, Ra_L: float, Pr: float) -> float:
+    def nusselt_L_vert(self, Ra_L: Union[float, Iterable[float]], 
+                       Pr: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computes Nusselt number Nu = Nu( Ra_L, Pr ) for natural convection
         at the vertical plate
 
         Args:
            Ra_L:
-               Rayleigh number [/] Ra = Gr_L * Pr
+               Rayleigh number [/] Ra = Gr_L * Pr, 0 < Ra_L < 1e30
 
            Pr:
                Prandtl number [/]
@@ -325,24 +459,24 @@ class FreeConvectionPlate(object):
             [INCR96] Equ (9.26) if Ra_L <= 1e9 and Equ. (9.27)
                      if Ra_L > 1e9
         """
-        assert Pr > 1e-20
-        assert 0 < Ra_L and Ra_L < 1e30
+        scalar = _is_scalar(Ra_L, Pr)
+        Ra_L, Pr = np.asfarray(Ra_L), np.asfarray(Pr)
 
-        if Ra_L <= 1e9:
-            return 0.68 + 0.67 * pow(Ra_L, 0.25) \
-                / pow(1 + pow(0.492 / Pr, 9./16), 4./9)
-        else:
-            return np.sqr(0.825 + 0.387 * np.pow(Ra_L, 1./6)
-                          / pow(1 + pow(0.492 / Pr, 9./16), 8./27))
+        psi = 1. + (0.492 / Pr)**(9./16)
+        Nu = np.where(Ra_L <= 1e9, 
+                      0.68 + 0.67 * Ra_L**0.25 / psi**(4./9),
+                      (0.825 + 0.387 * Ra_L**(1./6) / psi**(8./27))**2)
+        return _out(Nu, scalar)
 
-    def nusselt_L_upper(self, Ra_L: float) -> float:
+    def nusselt_L_upper(self, Ra_L: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computed Nusselt number Nu = Nu( Ra_L ) for natural convection
         at the upper surface of a heated plate
 
         Args:
             Ra_L:
-                Raleigh number [/] Ra = Gr_L * Pr
+                Raleigh number [/] Ra = Gr_L * Pr, 1e4 <= Ra_L <= 1e11
 
         Returns:
             Nusselt number [/]
@@ -351,21 +485,21 @@ class FreeConvectionPlate(object):
             [INCR96] Equ (9.30) if Ra_L <= 1e7 and
                      Equ. (9.31) if Ra_L > 1e7
         """
-        assert 1e4 <= Ra_L and Ra_L <= 1e11
+        scalar = _is_scalar(Ra_L)
+        Ra_L = np.asfarray(Ra_L)
 
-        if Ra_L <= 1e7:
-            return 0.54 * Ra_L**0.25
-        else:
-            return 0.15 * Ra_L**0.3333333
+        Nu = np.where(Ra_L <= 1e7, 0.54 * Ra_L**0.25, 0.15 * Ra_L**0.3333333)
+        return _out(Nu, scalar)
 
-    def nusselt_L_lower(self, Ra_L: float) -> float:
+    def nusselt_L_lower(self, Ra_L: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computes Nusselt number Nu = Nu( Ra_L ) for natural convection at
         the lower surface of a heated plate
 
         Args:
             Ra_L:
-                Raleigh number [/], Ra = Gr_L * Pr
+                Raleigh number [/], Ra = Gr_L * Pr, 1e5 <= Ra_L <= 1e11
 
         Returns:
             Nusselt number [/]
@@ -373,12 +507,29 @@ class FreeConvectionPlate(object):
         References:
             [INCR96] Equ (9.32) if Ra_L <= 1e10
         """
-        assert 1e5 <= Ra_L and Ra_L <= 1e11
+        scalar = _is_scalar(Ra_L)
 
-        return 0.27 * Ra_L**0.25
+        return _out(0.27 * np.asfarray(Ra_L)**0.25, scalar)
 
-    def rayleigh_L(self, T_surf: float, T_inf: float, L: float, 
-                   theta: float = 0.) -> float:
+    @staticmethod
+    def _rayleigh(T_surf: np.ndarray, T_inf: np.ndarray, L: np.ndarray, 
+                  theta: np.ndarray, T_film: np.ndarray, nu: np.ndarray, 
+                  a: np.ndarray) -> np.ndarray:
+        """
+        Rayleigh number from fluid properties at film temperature,
+        see rayleigh_L()
+        """
+        g = 9.81 * np.cos(np.radians(theta))
+        beta = 1.0 / T_film
+
+        return g * beta * np.abs(np.asfarray(T_surf) - T_inf) * \
+            np.asfarray(L)**3 / (nu * a)
+
+    def rayleigh_L(self, T_surf: Union[float, Iterable[float]], 
+                   T_inf: Union[float, Iterable[float]], 
+                   L: Union[float, Iterable[float]], 
+                   theta: Union[float, Iterable[float]] = 0.) \
+            -> Union[float, np.ndarray]:
         """
         Computes Rayleigh number Ra_L = Gr_L * Pr as function of
         temperature and characteristic length; theta can be optionally
@@ -416,20 +567,20 @@ class FreeConvectionPlate(object):
                     /<--->|
                    / theta|
            """
-        assert isinstance(self.fluid, Fluid)
-        assert T_inf > 200                 # both temperatures in Kelvin
-        assert T_surf > 0 and np.abs(T_surf - T_inf) > 0
-        assert L > 0
+        scalar = _is_scalar(T_surf, T_inf, L, theta)
+        T_surf, T_inf = np.asfarray(T_surf), np.asfarray(T_inf)
+        assert np.all(T_inf > 200)          # both temperatures in Kelvin
+        assert np.all((T_surf > 0) & (np.abs(T_surf - T_inf) > 0))
+        assert np.all(np.asfarray(L) > 0)
 
-        T_film = 0.5 * (T_surf + T_inf)
-        beta = 1.0 / T_film
-        nu = self.fluid.nu(T_film)
-        a = self.fluid.a(T_film)
-        g = 9.81 * np.cos(np.radians(theta))
+        T_film, k, nu, a = self.film_properties(T_surf, T_inf)
 
-        return g * beta * np.abs(T_surf - T_inf) * L**3 / (nu * a)
+        return _out(self._rayleigh(T_surf, T_inf, L, theta, T_film, nu, a),
+                    scalar)
 
-    def prandtl(self, T_surf: float, T_inf: float) -> float:
+    def prandtl(self, T_surf: Union[float, Iterable[float]], 
+                T_inf: Union[float, Iterable[float]]) \
+            -> Union[float, np.ndarray]:
         """
         Computes Prandtl number Pr as function of film temperature
         T_film = (T_surf + T_inf) / 2
@@ -444,10 +595,9 @@ class FreeConvectionPlate(object):
         Returns:
             Prandtl number [/]
         """
+        scalar = _is_scalar(T_surf, T_inf)
+        assert np.all((np.asfarray(T_surf) > 0) & (np.asfarray(T_inf) > 0))
 
-        assert isinstance(self.fluid, Fluid)
-        assert T_surf > 0 and T_inf > 0
-
-        T_film = 0.5 * (T_surf + T_inf)
+        T_film, k, nu, a = self.film_properties(T_surf, T_inf)
 
-        return self.fluid.Pr(T_film)
+        return _out(nu / a, scalar)
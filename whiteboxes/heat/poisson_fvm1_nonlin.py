@@ -20,21 +20,52 @@
       2023-12-04 DWW
 """
 
+from concurrent.futures import ProcessPoolExecutor, ThreadPoolExecutor
 import matplotlib.pyplot as plt
 from numba import jit
 import numpy as np
-from typing import Callable, Dict, Iterable, Optional, Tuple, Union
+import os
+from time import perf_counter
+from typing import Any, Callable, Dict, Iterable, List, Optional, Tuple, Union
 
-from whiteboxes.numerics.tdma import tdma
+from whiteboxes.mesh.distribution import Distribution
+from whiteboxes.mesh.partly_regular import PartlyRegularMesh
+from whiteboxes.numerics.tdma import tdma, tdma_batch
+from whiteboxes.tools import telemetry
 
 __all__ = ['poisson_bc1_bc1_fvm1', 'poisson_bc1_bc1_nonlin_fvm1',
            'dqdt_for_bc1_seq']
 
-@jit
-def _fvm1_equation_system(i, x_cen, x_vrt, T, conductivity, source,
+def _polynomial_vec(dT: float | np.ndarray, 
+                    coeff: Iterable[float]) -> float | np.ndarray:
+    """
+    Horner scheme for scalar or array 'dT', see _polynomial()
+    """
+    c = 0. * dT
+    for k in coeff[::-1]:
+        c = c * dT + k
+    return c
+
+
+@jit(nopython=True, cache=True)
+def _polynomial(dT: float, coeff: np.ndarray) -> float:
+    """
+    Horner scheme: coeff[0] + coeff[1]*dT + coeff[2]*dT^2 + ...
+    """
+    c = 0.
+    for j in range(coeff.size - 1, -1, -1):
+        c = c * dT + coeff[j]
+    return c
+
+
+@jit(nopython=True, cache=True)
+def _fvm1_equation_system(x_cen, x_vrt, T, k_coeff, T_ref, s_coeff,
                           Lo, Di, Up, Rs):
     """
-    assembling of matrix [Lo, Di, Up] and right-hand side vector {Rs}
+    Compiled assembling of matrix [Lo, Di, Up] and right-hand side 
+    vector {Rs} for all inner cells. Conductivity and source are 
+    polynomials of (T - T_ref) defined by 'k_coeff' and 's_coeff'; 
+    an empty 's_coeff' means zero source
 
                T_w       T_e
                 |         |
@@ -44,26 +75,346 @@ def _fvm1_equation_system(i, x_cen, x_vrt, T, conductivity, source,
         -----------------------------
                      ^
                      | T
-    """        
-    # unknown at cell faces
-    T_w = (T[i] + T[i-1]) / 2
-    T_e = (T[i+1] + T[i]) / 2
-    
-    # conductivity at cell faces k_w = k(x_w=x_vrt[i-1], T_w)
-    k_w = conductivity(x_vrt[i-1], T_w)
-    k_e = conductivity(x_vrt[i], T_e)
-    
-    Up[i] = -k_e / (x_cen[i+1] - x_cen[i])
-    Lo[i] = -k_w / (x_cen[i] - x_cen[i-1])
-    Di[i] = - Up[i] - Lo[i]
+    """
+    # conductivity at west face of first inner cell
+    k_w = _polynomial((T[1] + T[0]) / 2 - T_ref, k_coeff)
+    for i in range(1, x_cen.size-1):
+        # conductivity at east face, re-used as west face of next cell
+        k_e = _polynomial((T[i+1] + T[i]) / 2 - T_ref, k_coeff)
+
+        Up[i] = -k_e / (x_cen[i+1] - x_cen[i])
+        Lo[i] = -k_w / (x_cen[i] - x_cen[i-1])
+        Di[i] = - Up[i] - Lo[i]
+        if s_coeff.size == 0:
+            Rs[i] = 0.
+        else:
+            Rs[i] = (x_vrt[i] - x_vrt[i-1]) * \
+                _polynomial(T[i] - T_ref, s_coeff)
+        k_w = k_e
+
+    return Lo, Di, Up, Rs
+
+
+def _fvm1_equation_system_vec(x_cen, x_vrt, T, conductivity, source,
+                              Lo, Di, Up, Rs):
+    """
+    Assembling of [Lo, Di, Up] and {Rs} for all inner cells with single 
+    calls of vectorized 'conductivity' and 'source' functions
+
+    Raises:
+        exception of conductivity or source if they do not accept arrays
+    """
+    # conductivity at the faces between cell j and cell j+1 
+    T_f = (T[1:] + T[:-1]) / 2
+    k_f = np.broadcast_to(np.asfarray(conductivity(x_vrt[:-1], T_f)), 
+                          T_f.shape)
+
+    Up[1:-1] = -k_f[1:] / (x_cen[2:] - x_cen[1:-1])
+    Lo[1:-1] = -k_f[:-1] / (x_cen[1:-1] - x_cen[:-2])
+    Di[1:-1] = - Up[1:-1] - Lo[1:-1]
     if source is None:
-        Rs[i] = 0.
+        Rs[1:-1] = 0.
     else:
-        Rs[i] = (x_vrt[i] - x_vrt[i-1]) * source(x_cen[i], T[i])
+        Rs[1:-1] = (x_vrt[1:-1] - x_vrt[:-2]) * \
+            np.broadcast_to(np.asfarray(source(x_cen[1:-1], T[1:-1])), 
+                            T[1:-1].shape)
 
     return Lo, Di, Up, Rs
 
 
+def _fvm1_equation_system_loop(x_cen, x_vrt, T, conductivity, source,
+                               Lo, Di, Up, Rs):
+    """
+    Assembling of [Lo, Di, Up] and {Rs} cell by cell with scalar calls 
+    of 'conductivity' and 'source' functions
+    """
+    for i in range(1, x_cen.size-1):
+        """
+        assembling of matrix [Lo, Di, Up] and right-hand side vector {Rs}
+
+                   T_w       T_e
+                    |         |
+                    v         v
+            -----------------------------
+        ... |   +   |    +    |    +    | ...
+            -----------------------------
+                         ^
+                         | T
+        """        
+        # unknown at cell faces
+        T_w = (T[i] + T[i-1]) / 2
+        T_e = (T[i+1] + T[i]) / 2
+        
+        # conductivity at cell faces k_w = k(x_w=x_vrt[i-1], T_w)
+        k_w = conductivity(x_vrt[i-1], T_w)
+        k_e = conductivity(x_vrt[i], T_e)
+        
+        Up[i] = -k_e / (x_cen[i+1] - x_cen[i])
+        Lo[i] = -k_w / (x_cen[i] - x_cen[i-1])
+        Di[i] = - Up[i] - Lo[i]
+        if source is None:
+            Rs[i] = 0.
+        else:
+            Rs[i] = (x_vrt[i] - x_vrt[i-1]) * source(x_cen[i], T[i])
+
+    return Lo, Di, Up, Rs
+
+
+def _constant_conductivity(conductivity: Any) -> float | None:
+    """
+    Returns:
+        conductivity as plain float if 'conductivity' is a number or a 
+        constant Property, see Property.constant_value 
+        OR
+        None if conductivity is a function
+    """
+    value = getattr(conductivity, 'constant_value', conductivity)
+    if isinstance(value, (int, float, np.number)) and \
+            not isinstance(value, bool):
+        return float(value)
+    return None
+
+
+def _fvm1_options(kwargs: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Resolves keyword arguments of poisson_bc1_bc1_fvm1()
+
+    Returns:
+        dictionary of options with resolved 'assembly' variant
+    """
+    assembly: str = kwargs.get('assembly', 'auto')
+    conductivity: Callable[[float], float] = kwargs.get('conductivity', None) 
+    k_coeff: Iterable[float] | None = kwargs.get('k_coeff', None)
+    s_coeff: Iterable[float] | None = kwargs.get('s_coeff', None)
+    source: Callable[[float], float] = kwargs.get('source', None)
+    T_ref: float = kwargs.get('T_ref', 0.)
+    
+    # constant conductivity is passed to the compiled kernel as number
+    k_const = _constant_conductivity(conductivity)
+    if k_const is not None:
+        conductivity, k_coeff = None, (k_const,)
+    if conductivity is None and k_coeff is None:
+        k_coeff = (1.,)
+    if k_coeff is not None:
+        k_coeff = np.atleast_1d(np.asfarray(k_coeff))
+    if s_coeff is not None:
+        s_coeff = np.atleast_1d(np.asfarray(s_coeff))
+    if assembly == 'auto':
+        assembly = 'compiled' if k_coeff is not None else 'vectorized'
+
+    # polynomials allow analytic derivatives dk/dT and dS/dT 
+    k_analytic = k_coeff is not None and (conductivity is None or 
+                                          assembly == 'compiled')
+    s_analytic = s_coeff is not None and (source is None or 
+                                          assembly == 'compiled')
+    if assembly == 'compiled':
+        assert k_coeff is not None, "assembly 'compiled' requires 'k_coeff'"
+        assert source is None or s_coeff is not None, \
+            "assembly 'compiled' requires 's_coeff' instead of 'source'"
+        if s_coeff is None:
+            s_coeff = np.zeros(0)
+    else:
+        if conductivity is None:
+            conductivity = lambda x, T: _polynomial_vec(T - T_ref, k_coeff)
+        if source is None and s_coeff is not None:
+            source = lambda x, T: _polynomial_vec(T - T_ref, s_coeff)
+
+    return {'assembly': assembly, 
+            'conductivity': conductivity, 
+            'k_analytic': k_analytic, 
+            'k_coeff': k_coeff, 
+            'L': kwargs.get('L', 1.), 
+            'mesh': kwargs.get('mesh', None), 
+            'n_vol': kwargs.get('n_vol', 50), 
+            's_analytic': s_analytic, 
+            's_coeff': s_coeff, 
+            'source': source, 
+            'T_ref': float(T_ref), 
+            'T_west': kwargs.get('T_west', 0.), 
+            'T_east': kwargs.get('T_east', 1.)}
+
+
+def _fvm1_vertices(L: float, n_vol: int, 
+                   mesh: Any = None) -> np.ndarray:
+    """
+    Cell faces of the mesh without ghost cells
+
+    Args:
+        L:
+            length of domain if 'mesh' is None or a Distribution
+        n_vol:
+            number of finite volumes if 'mesh' is None or a Distribution
+        mesh:
+            None: uniform mesh with Dx = L / n_vol
+            Distribution: graded mesh on [0, L] with faces from 
+                Distribution.density(), e.g. Distribution.LOG_PLUS
+            PartlyRegularMesh: 1D mesh, e.g. with spacing 'log+'
+            1D array of float: externally generated face coordinates
+
+    Returns:
+        strictly increasing coordinates of cell faces, size: n_vol+1
+    """
+    if mesh is None:
+        X = np.linspace(0., L, n_vol + 1)
+    elif isinstance(mesh, Distribution):
+        assert mesh not in (Distribution.RANDOM, Distribution.USER), \
+            str(mesh)
+        X = L * np.array([Distribution.density(i, mesh, 0, n_vol) 
+                          for i in range(n_vol + 1)])
+    elif isinstance(mesh, PartlyRegularMesh):
+        assert mesh.ndim == 1, str(mesh.ndim)
+        # last vertex of PartlyRegularMesh belongs to the ghost cell
+        X = np.asfarray(mesh.X1d[0][:-1])
+    else:
+        X = np.asfarray(mesh)
+    assert X.ndim == 1 and X.size > 1, str(X.shape)
+    assert np.all(X[1:] > X[:-1]), 'faces must be strictly increasing'
+
+    return X
+
+
+def _fvm1_mesh(L: float, n_vol: int, 
+               mesh: Any = None) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Mesh generation, cells with index 0 and n_vol+1 are ghostcells
+    of zero width at the boundaries, see _fvm1_vertices() for 'mesh'
+
+    Returns:
+        x_cen:
+            coordinates of cell centers, size: n_vol+2
+        x_vrt:
+            coordinates of east faces of cells, size: n_vol+2
+    """
+    X = _fvm1_vertices(L, n_vol, mesh)
+    x_cen = np.empty(X.size + 1)
+    x_cen[0], x_cen[-1] = X[0], X[-1]
+    x_cen[1:-1] = 0.5 * (X[1:] + X[:-1])
+    x_vrt = np.append(X, X[-1])
+
+    return x_cen, x_vrt
+
+
+def _fvm1_solver_mesh(opt: Dict[str, Any], T: np.ndarray | None
+                      ) -> Tuple[np.ndarray, np.ndarray] | None:
+    """
+    Mesh of the solvers. The number of volumes is given by opt['mesh'] 
+    if it defines the faces, otherwise by T or by opt['n_vol']
+
+    Returns:
+        x_cen, x_vrt, see _fvm1_mesh()
+        OR
+        None if mesh has less than 3 finite volumes
+    """
+    n_vol = opt['n_vol'] if T is None else len(T) - 2
+    if opt['mesh'] is None or isinstance(opt['mesh'], Distribution):
+        if n_vol < 3:
+            return None
+    x_cen, x_vrt = _fvm1_mesh(opt['L'], n_vol, opt['mesh'])
+    if x_cen.size - 2 < 3:
+        return None
+
+    return x_cen, x_vrt
+
+
+def _fvm1_assemble(opt: Dict[str, Any], x_cen: np.ndarray, 
+                   x_vrt: np.ndarray, T: np.ndarray, 
+                   Lo: np.ndarray, Di: np.ndarray, Up: np.ndarray, 
+                   Rs: np.ndarray) -> None:
+    """
+    Assembles [Lo, Di, Up] and {Rs} in place, including the Dirichlet 
+    conditions at west and east boundary, see poisson_bc1_bc1_fvm1()
+    """
+    if opt['assembly'] == 'compiled':
+        _fvm1_equation_system(x_cen, x_vrt, T, opt['k_coeff'], opt['T_ref'], 
+                              opt['s_coeff'], Lo, Di, Up, Rs)
+    elif opt['assembly'] == 'vectorized':
+        try:
+            _fvm1_equation_system_vec(x_cen, x_vrt, T, opt['conductivity'], 
+                                      opt['source'], Lo, Di, Up, Rs)
+        except Exception:
+            # callables do not accept arrays
+            opt['assembly'] = 'loop'
+    if opt['assembly'] == 'loop':
+        _fvm1_equation_system_loop(x_cen, x_vrt, T, opt['conductivity'], 
+                                   opt['source'], Lo, Di, Up, Rs)
+
+    # Dirichlet condition at west boundary of domain
+    # T_0 * 1 + 0 * T_1 = T_0
+    Di[0] = 1.
+    Up[0] = 0.
+    Rs[0] = opt['T_west']
+
+    # Dirichlet condition at east boundary of domain
+    # T_{n_vol} * 0 + T_{n_vol+1} * 1 = T_{n_vol+1}
+    Lo[-1] = 0.
+    Di[-1] = 1.
+    Rs[-1] = opt['T_east']
+
+
+def _fvm1_face_conductivity(opt: Dict[str, Any], x_vrt: np.ndarray, 
+                            T: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Conductivity k and its derivative dk/dT at the faces between cell j 
+    and cell j+1. The derivative is analytic for polynomial 'k_coeff', 
+    otherwise it is approximated by central differences
+
+    Returns:
+        k_f:
+            conductivity at faces
+        dkdT_f:
+            derivative of conductivity at faces
+    """
+    T_f = (T[1:] + T[:-1]) / 2
+    if opt['k_analytic']:
+        k_coeff = opt['k_coeff']
+        dk_coeff = k_coeff[1:] * np.arange(1, k_coeff.size)
+        dT = T_f - opt['T_ref']
+        return _polynomial_vec(dT, k_coeff), _polynomial_vec(dT, dk_coeff)
+
+    h = 1e-6 * (1. + np.abs(T_f))
+    k = _fvm1_evaluate(opt['conductivity'], x_vrt[:-1], T_f)
+    k_p = _fvm1_evaluate(opt['conductivity'], x_vrt[:-1], T_f + h)
+    k_m = _fvm1_evaluate(opt['conductivity'], x_vrt[:-1], T_f - h)
+
+    return k, (k_p - k_m) / (2 * h)
+
+
+def _fvm1_source_derivative(opt: Dict[str, Any], x_cen: np.ndarray, 
+                            T: np.ndarray) -> np.ndarray:
+    """
+    Derivative dS/dT of source at the inner cell centers
+
+    Returns:
+        derivative of source, zero if there is no source
+    """
+    if opt['s_analytic'] or opt['assembly'] == 'compiled':
+        s_coeff = opt['s_coeff']
+        if s_coeff.size < 2:
+            return np.zeros(T.size - 2)
+        ds_coeff = s_coeff[1:] * np.arange(1, s_coeff.size)
+        return _polynomial_vec(T[1:-1] - opt['T_ref'], ds_coeff)
+    if opt['source'] is None:
+        return np.zeros(T.size - 2)
+
+    h = 1e-6 * (1. + np.abs(T[1:-1]))
+    s_p = _fvm1_evaluate(opt['source'], x_cen[1:-1], T[1:-1] + h)
+    s_m = _fvm1_evaluate(opt['source'], x_cen[1:-1], T[1:-1] - h)
+
+    return (s_p - s_m) / (2 * h)
+
+
+def _fvm1_evaluate(func: Callable[[float, float], float], x: np.ndarray, 
+                   T: np.ndarray) -> np.ndarray:
+    """
+    Evaluates func(x, T) for arrays, with element-wise fallback if 
+    func does not accept arrays
+    """
+    try:
+        return np.array(np.broadcast_to(np.asfarray(func(x, T)), T.shape))
+    except Exception:
+        return np.array([func(x_, T_) for x_, T_ in zip(x, T)], dtype=float)
+
+
 def poisson_bc1_bc1_fvm1(T: np.ndarray | None = None, 
                          **kwargs: Any) -> Tuple[np.array, np.ndarray, float, float] | None:
     """
@@ -72,7 +423,35 @@ def poisson_bc1_bc1_fvm1(T: np.ndarray | None = None,
     
         d/dx[k(x) dT/dx] = S(x), 
             domain: [0, L], boundary conditions: T(x=0), T(x=L) 
-    
+
+    Kwargs:
+        assembly (str):
+            'compiled': compiled kernel, requires polynomial 'k_coeff'
+                and optional 's_coeff' instead of callables
+            'vectorized': single call of 'conductivity' and 'source' 
+                with arrays of all cells
+            'loop': scalar calls of 'conductivity' and 'source' per cell
+            'auto': 'compiled' if 'k_coeff' is given, otherwise 
+                'vectorized' with fallback to 'loop' [default]
+        conductivity (Callable[[float, float], float]):
+            conductivity k(x, T), 
+            OR
+            constant conductivity as number or as constant Property
+        k_coeff (Iterable[float]):
+            conductivity as polynomial: k0 + k1*(T-T_ref) + k2*(T-T_ref)^2 
+            + ..., replaces 'conductivity'
+        L (float):
+            length of domain if 'mesh' is None or a Distribution
+        mesh (None, Distribution, PartlyRegularMesh or 1D array):
+            nonuniform mesh, replaces 'L' and 'n_vol' except for 
+            Distribution, see _fvm1_vertices() [default: uniform]
+        n_vol (int):
+            number of finite volumes
+        s_coeff (Iterable[float]):
+            source as polynomial of (T-T_ref), replaces 'source'
+        T_ref (float):
+            reference temperature of 'k_coeff' and 's_coeff' 
+        
     Returns:
         x (1D array of float): 
             independent variable
@@ -90,81 +469,22 @@ def poisson_bc1_bc1_fvm1(T: np.ndarray | None = None,
         :                                     :
         :<------------- L --- ... ---------- >:            
     """
-    precompiled_code = not True  # chose this option for employing jit
-
-    conductivity: Callable[[float], float] = kwargs.get('conductivity', None) 
-    L: float = kwargs.get('L', 1.) 
-    n_vol: int = kwargs.get('n_vol', 50)
-    source: Callable[[float], float] = kwargs.get('source', None)
-    T_west: float = kwargs.get('T_west', 0.)
-    T_east: float = kwargs.get('T_east', 1.)
+    opt = _fvm1_options(kwargs)
     
-    if conductivity is None:
-        conductivity = lambda x, T: 1.    
-    if T is not None:
-        n_vol = len(T) - 1
-    if n_vol < 3:
+    mesh = _fvm1_solver_mesh(opt, T)
+    if mesh is None:
         return None
-    
-    # mesh generation, cells with index 0 and n_vol+1 are ghostcells
-    # with a reduced width of Dx/2
-    Dx = L / n_vol
-    x_cen = np.arange(-Dx/2, L + Dx/2, Dx)
-    x_cen[0], x_cen[-1] = 0., L
-    x_vrt = x_cen + Dx / 2
-    x_vrt[0], x_vrt[-1] = x_cen[0], x_cen[-1]
-
+    x_cen, x_vrt = mesh
 
     if T is None:
-        T = np.linspace(T_west, T_east, x_cen.size)
+        T = np.linspace(opt['T_west'], opt['T_east'], x_cen.size)
+    T = np.asfarray(T)
+    assert T.size == x_cen.size, str((T.size, x_cen.size))
 
     Lo, Di = np.zeros(x_cen.size), np.zeros(x_cen.size)
     Up, Rs = np.zeros(x_cen.size), np.zeros(x_cen.size)
 
-    for i in range(1, x_cen.size-1):
-        """
-        assembling of matrix [Lo, Di, Up] and right-hand side vector {Rs}
-
-                   T_w       T_e
-                    |         |
-                    v         v
-            -----------------------------
-        ... |   +   |    +    |    +    | ...
-            -----------------------------
-                         ^
-                         | T
-        """        
-        if precompiled_code:
-            Lo, Di, Up, Rs = _fvm1_equation_system(i, x_cen, x_vrt, T, 
-                conductivity, source, Lo, Di, Up, Rs)
-        else:
-            # unknown at cell faces
-            T_w = (T[i] + T[i-1]) / 2
-            T_e = (T[i+1] + T[i]) / 2
-            
-            # conductivity at cell faces k_w = k(x_w=x_vrt[i-1], T_w)
-            k_w = conductivity(x_vrt[i-1], T_w)
-            k_e = conductivity(x_vrt[i], T_e)
-            
-            Up[i] = -k_e / (x_cen[i+1] - x_cen[i])
-            Lo[i] = -k_w / (x_cen[i] - x_cen[i-1])
-            Di[i] = - Up[i] - Lo[i]
-            if source is None:
-                Rs[i] = 0.
-            else:
-                Rs[i] = (x_vrt[i] - x_vrt[i-1]) * source(x_cen[i], T[i])
-
-    # Dirichlet condition at west boundary of domain
-    # T_0 * 1 + 0 * T_1 = T_0
-    Di[0] = 1.
-    Up[0] = 0.
-    Rs[0] = T_west
-
-    # Dirichlet condition at east boundary of domain
-    # T_{n_vol} * 0 + T_{n_vol+1} * 1 = T_{n_vol+1}
-    Lo[-1] = 0.
-    Di[-1] = 1.
-    Rs[-1] = T_east
+    _fvm1_assemble(opt, x_cen, x_vrt, T, Lo, Di, Up, Rs)
 
     T = tdma(Lo, Di, Up, Rs)
     
@@ -194,11 +514,22 @@ def poisson_bc1_bc1_nonlin_fvm1(T: np.ndarray | None = None, **kwargs: Any
         max_it (int):
             maximum number of iterations
         min_it (int):
-            minimum number of iterations        
+            minimum number of iterations, default: 3 for 'picard' and 
+            1 for 'newton' and 'anderson'
+        method (str):
+            'picard': fixed-point iteration with linearized k(T) [default]
+            'newton': Newton iteration with tridiagonal Jacobian, dk/dT 
+                is analytic for polynomial 'k_coeff', otherwise it is 
+                approximated by central differences
+            'anderson': Picard iteration with Anderson acceleration
+        m_anderson (int):
+            number of previous iterations used by Anderson acceleration 
+        mesh (None, Distribution, PartlyRegularMesh or 1D array):
+            nonuniform mesh, see poisson_bc1_bc1_fvm1() 
         mse (float):
             stop iteration, if mean square difference less than 'mse'
         omega (float):
-            under-relaxation
+            under-relaxation, for 'newton': damping of Newton step
         source (callable):
             right-hand side source term
         conductivity (callable):
@@ -228,62 +559,263 @@ def poisson_bc1_bc1_nonlin_fvm1(T: np.ndarray | None = None, **kwargs: Any
                 history of temperature gradient at west boundary 
             'hist_dTdx_east ':
                 history of temperature gradient at east boundary 
+            'hist_time':
+                history of elapsed wall time [s]
+
+            'it' (int):
+                index of last iteration
+            'method' (str):
+                iteration method
     """
     conductivity: Callable[[float], float] = kwargs.get('conductivity',
                                                       lambda x, T: 1 + T * 0.1) 
-    L: int = kwargs.get('L', 1.)
+    k_const = _constant_conductivity(conductivity)
+    if k_const is not None:
+        conductivity = lambda x, T: k_const
+    if 'k_coeff' in kwargs and 'conductivity' not in kwargs:
+        k_coeff = np.atleast_1d(kwargs['k_coeff'])
+        T_ref = kwargs.get('T_ref', 0.)
+        conductivity = lambda x, T: _polynomial_vec(T - T_ref, k_coeff)
+    m_anderson: int = kwargs.get('m_anderson', 5)
     max_it: int = kwargs.get('max_it', 50)
-    min_it: int = kwargs.get('min_it', 3)
+    method: str = kwargs.get('method', 'picard')
+    min_it: int = kwargs.get('min_it', 3 if method == 'picard' else 1)
     mse: float = kwargs.get('mse', 1e-4)
     omega = kwargs.get('omega', 1.0)
+    assert method in ('picard', 'newton', 'anderson'), str(method)
+    
+    opt = _fvm1_options(kwargs)
+
+    # mesh and work arrays are shared by all iterations
+    mesh = _fvm1_solver_mesh(opt, T)
+    if mesh is None:
+        return None
+    x_cen, x_vrt = mesh
+    n = x_cen.size
+    if T is None:
+        T = np.linspace(opt['T_west'], opt['T_east'], n)
+    else:
+        T = np.array(T, dtype=float)
+        assert T.size == n, str((T.size, n))
+    Lo, Di, Up, Rs = np.zeros(n), np.zeros(n), np.zeros(n), np.zeros(n)
+    if method == 'newton':
+        F = np.zeros(n)
+        J_lo, J_di, J_up = np.zeros(n), np.zeros(n), np.zeros(n)
+        dx_e = x_cen[2:] - x_cen[1:-1]
+        dx_w = x_cen[1:-1] - x_cen[:-2]
+        vol = x_vrt[1:-1] - x_vrt[:-2]
+    if method == 'anderson':
+        m_anderson = max(1, m_anderson)
+        dF = np.zeros((n, m_anderson))
+        dG = np.zeros((n, m_anderson))
+        f_prv, G_prv = np.zeros(n), np.zeros(n)
     
     result = {}
     result['hist_mse'] = []
     result['hist_dTdx_west'] = []
     result['hist_dTdx_east'] = []
+    result['hist_time'] = []
 
-    T_prv = None    
+    start = perf_counter()
+    converged = False
     for it in range(max_it):
-        if T_prv is None:
-            T_prv = T
+        _fvm1_assemble(opt, x_cen, x_vrt, T, Lo, Di, Up, Rs)
+
+        if method == 'newton':
+            # residual F(T) = A(T) * T - Rs(T)
+            F[:] = Di * T - Rs
+            F[1:] += Lo[1:] * T[:-1]
+            F[:-1] += Up[:-1] * T[1:]
+
+            # tridiagonal Jacobian: A(T) + dA/dT * T - dRs/dT
+            k_f, dkdT_f = _fvm1_face_conductivity(opt, x_vrt, T)
+            g_e = 0.5 * dkdT_f[1:] * (T[1:-1] - T[2:]) / dx_e
+            g_w = 0.5 * dkdT_f[:-1] * (T[1:-1] - T[:-2]) / dx_w
+            J_lo[:], J_di[:], J_up[:] = Lo, Di, Up
+            J_lo[1:-1] += g_w
+            J_up[1:-1] += g_e
+            J_di[1:-1] += g_e + g_w - vol * _fvm1_source_derivative(opt, 
+                                                                x_cen, T)
+            dT = omega * tdma(J_lo, J_di, J_up, -F)
+            mse_ = np.mean(np.square(dT))
+            T = T + dT
+            T_sol = T
         else:
-            T_prv = T_prv * (1 - omega) + T * omega
-        res = poisson_bc1_bc1_fvm1(T=T_prv, **kwargs)
-        if res is None:
-            return None
-        
-        x, T, dTdx_west, dTdx_east = res
+            G = tdma(Lo, Di, Up, Rs)
+            f = G - T
+            mse_ = np.mean(np.square(f))
+            T_sol = G
+            if method == 'anderson' and it > 0:
+                # column of ring buffer, m_k: number of stored columns
+                j = (it - 1) % m_anderson
+                dF[:, j] = f - f_prv
+                dG[:, j] = G - G_prv
+                m_k = min(it, m_anderson)
+                gamma = np.linalg.lstsq(dF[:, :m_k], f, rcond=None)[0]
+                f_prv[:], G_prv[:] = f, G
+                T = G - dG[:, :m_k] @ gamma \
+                    - (1 - omega) * (f - dF[:, :m_k] @ gamma)
+            else:
+                if method == 'anderson':
+                    f_prv[:], G_prv[:] = f, G
+                T = T * (1 - omega) + G * omega
+
+        dTdx_west = (T_sol[1] - T_sol[0]) / (x_cen[1] - x_cen[0])
+        dTdx_east = (T_sol[-1] - T_sol[-2]) / (x_cen[-1] - x_cen[-2])
+
+        result['hist_mse'].append(mse_)
+        result['hist_dTdx_west'].append(dTdx_west)
+        result['hist_dTdx_east'].append(dTdx_east)
+        result['hist_time'].append(perf_counter() - start)
+        telemetry.iteration('poisson_bc1_bc1_nonlin_fvm1', it, mse_, 
+                            method=method)
         
-        if T_prv is not None:
-            mse_ = np.mean(np.square(T - T_prv))
-            
-            result['hist_mse'].append(mse_)
-            result['hist_dTdx_west'].append(dTdx_west)
-            result['hist_dTdx_east'].append(dTdx_east)
-            
-            if mse_ < mse and it > min_it:
-                break
+        if mse_ < mse and it > min_it:
+            converged = True
+            break
+    telemetry.event('poisson_bc1_bc1_nonlin_fvm1', 
+                    'converged' if converged else 'max_it', it, mse_)
+
+    T, x = T_sol, x_cen
             
     n_w, n_e = -1, +1  # outward pointing normal at west and east boundary
 
     result['T'] = T
     result['x'] = x
     result['it'] = it
+    result['method'] = method
     result['dTdx_west'] = dTdx_west
     result['dTdx_east'] = dTdx_east
-    result['dqdt_west'] = n_w * dTdx_west * conductivity(x=0, T=T[0])
-    result['dqdt_east'] = n_e * dTdx_east * conductivity(x=L, T=T[-1])
+    result['dqdt_west'] = n_w * dTdx_west * conductivity(x=x_cen[0], T=T[0])
+    result['dqdt_east'] = n_e * dTdx_east * conductivity(x=x_cen[-1], 
+                                                         T=T[-1])
         
     return result
 
 
+def _dqdt_for_bc1_chunk(pairs: Iterable[Tuple[float, float]],
+                        k_coeff: np.ndarray,
+                        T_ref: float,
+                        L: float,
+                        n_vol: int,
+                        mse: float,
+                        method: str,
+                        warm_start: bool,
+                        mesh: Any = None,
+                        return_solutions: bool = False
+                        ) -> List[Tuple[float, float, np.ndarray | None]]:
+    """
+    Solves a contiguous chunk of (T_west, T_east) combinations for 
+    dqdt_for_bc1_seq(). Module-level function, can be pickled for 
+    worker processes. Does not plot
+
+    If 'warm_start' is True, each solve starts from the solution of the 
+    previous combination, shifted linearly to the new boundary values
+
+    Returns:
+        list of (dqdt_west, dqdt_east, T) per combination, 
+        T is None if not 'return_solutions'
+    """
+    results = []
+    T_prv, T_west_prv, T_east_prv = None, None, None
+    for T_west_i, T_east_i in pairs:
+        T_init = None
+        if warm_start and T_prv is not None:
+            T_init = T_prv + np.linspace(T_west_i - T_west_prv, 
+                                         T_east_i - T_east_prv, T_prv.size)
+        res = poisson_bc1_bc1_nonlin_fvm1(
+            T=T_init, 
+            L=L, 
+            mesh=mesh,
+            n_vol=n_vol, 
+            T_west=T_west_i, 
+            T_east=T_east_i, 
+            k_coeff=k_coeff,
+            T_ref=T_ref,
+            source=None,
+            mse=mse,
+            method=method,
+            silent=True)
+        T_prv, T_west_prv, T_east_prv = res['T'], T_west_i, T_east_i
+        results.append((res['dqdt_west'], res['dqdt_east'], 
+                        res['T'] if return_solutions else None))
+
+    return results
+
+
+def _dqdt_for_bc1_batch(pairs: Iterable[Tuple[float, float]],
+                        k_coeff: np.ndarray,
+                        T_ref: float,
+                        L: float,
+                        n_vol: int,
+                        mse: float,
+                        method: str,
+                        warm_start: bool,
+                        mesh: Any = None,
+                        return_solutions: bool = False,
+                        max_it: int = 50,
+                        min_it: int = 3
+                        ) -> List[Tuple[float, float, np.ndarray | None]]:
+    """
+    Solves all (T_west, T_east) combinations of a chunk simultaneously 
+    with Picard iterations. Each iteration assembles all systems as 
+    array operations and solves them with a single call of tdma_batch()
+
+    The iteration of the batch stops if the mean square difference of 
+    every system is less than 'mse'. Arguments 'method' and 'warm_start' 
+    are ignored, see _dqdt_for_bc1_chunk() for the other arguments
+
+    Returns:
+        list of (dqdt_west, dqdt_east, T) per combination, 
+        T is None if not 'return_solutions'
+    """
+    T_w, T_e = np.asfarray(pairs).T
+    x_cen, x_vrt = _fvm1_mesh(L, n_vol, mesh)
+    dx = np.diff(x_cen)[:, np.newaxis]
+
+    # layout (N, M): N cells, M systems on the fast axis
+    T = T_w + np.outer((x_cen - x_cen[0]) / (x_cen[-1] - x_cen[0]), T_e - T_w)
+    Lo, Di, Up, Rs = (np.zeros(T.shape) for _ in range(4))
+    Di[0], Rs[0] = 1., T_w
+    Di[-1], Rs[-1] = 1., T_e    
+    for it in range(max_it):
+        k_f = _polynomial_vec((T[1:] + T[:-1]) / 2 - T_ref, k_coeff)
+        Up[1:-1] = -k_f[1:] / dx[1:]
+        Lo[1:-1] = -k_f[:-1] / dx[:-1]
+        Di[1:-1] = - Up[1:-1] - Lo[1:-1]
+        
+        T_prv, T = T, tdma_batch(Lo, Di, Up, Rs)
+        mse_ = np.mean(np.square(T - T_prv), axis=0).max()
+        telemetry.iteration('_dqdt_for_bc1_batch', it, mse_, 
+                            n_systems=T.shape[1])
+        if mse_ < mse and it > min_it:
+            break
+
+    dTdx_west = (T[1] - T[0]) / (x_cen[1] - x_cen[0])
+    dTdx_east = (T[-1] - T[-2]) / (x_cen[-1] - x_cen[-2])
+    n_w, n_e = -1, +1  # outward pointing normal at west and east boundary
+    dqdt_west = n_w * dTdx_west * _polynomial_vec(T[0] - T_ref, k_coeff)
+    dqdt_east = n_e * dTdx_east * _polynomial_vec(T[-1] - T_ref, k_coeff)
+
+    return [(dqdt_west[j], dqdt_east[j], 
+             T[:, j] if return_solutions else None) 
+            for j in range(T.shape[1])]
+
+
 def dqdt_for_bc1_seq(k_coeff: Iterable[float] | None = None, 
                      T_west: float | Iterable[float] = 0.,
                      T_east: float | Iterable[float] = 1., 
                      T_ref: float | None = 0.,
                      L: float = 1.0, 
                      n_vol: int = 1000,
+                     mesh: Any = None,
                      mse: float = 1e-3,
+                     method: str = 'picard',
+                     warm_start: bool = True,
+                     n_jobs: int | None = 1,
+                     chunk_size: int | None = None,
+                     executor: str = 'process',
+                     batched: bool = False,
                      plot_scale: Tuple[Tuple[float, str], 
                                        Tuple[float, str]] | None = None,
                      silent: bool = True,
@@ -319,10 +851,35 @@ def dqdt_for_bc1_seq(k_coeff: Iterable[float] | None = None,
             length
         n_vol
             number of finite volumes
+        mesh:
+            nonuniform mesh, replaces 'L' and 'n_vol' except for 
+            Distribution, see poisson_bc1_bc1_fvm1()
+        mse:
+            stop iteration, if mean square difference less than 'mse'
+        method:
+            iteration method 'picard', 'newton' or 'anderson', 
+            see poisson_bc1_bc1_nonlin_fvm1()
+        warm_start:
+            if True, then each solve starts from the solution of the 
+            previous combination in the same chunk
+        n_jobs:
+            number of parallel workers; if None, number of CPUs is used.
+            If n_jobs is 1, combinations are solved in calling process
+        chunk_size:
+            number of contiguous combinations per work item; 
+            if None, about four chunks per worker (one if 'batched') 
+            are created
+        executor:
+            'process' or 'thread' pool for n_jobs > 1
+        batched:
+            if True, then all combinations of a chunk are solved 
+            simultaneously by Picard iteration with tdma_batch(); 
+            'method' and 'warm_start' are ignored
         plot_scale:
             Pair of (scale, unit) pairs for axis labelling and scaling
         silent:
-            if False, then plot sequence of iterative solutions
+            if False, then plot sequence of iterative solutions;
+            plotting is disabled if n_jobs is not 1
         
     Returns:
         dqdt_west:
@@ -342,54 +899,59 @@ def dqdt_for_bc1_seq(k_coeff: Iterable[float] | None = None,
         
     if k_coeff is None:
         k_coeff = (1., 0.)
-    k_coeff = np.atleast_1d(k_coeff)
-
-    def conductivity(x, T):
-        n = len(k_coeff)
-        dT = T - T_ref
-        sqr_dT = dT * dT
-        
-        c = 0.
-        if n > 0:
-            c += k_coeff[0]
-        if n > 1:
-            c += k_coeff[1] * dT
-        if n > 2:
-            c += k_coeff[2] * sqr_dT
-        if n > 3:
-            c += k_coeff[3] * dT * sqr_dT
-        if n > 4:
-            c += k_coeff[4] * sqr_dT * sqr_dT
-            
-        return c
+    k_coeff = np.atleast_1d(np.asfarray(k_coeff))
     
-    dqdt_west, dqdt_east = [], []
-    for T_west_i in T_west:
-        for T_east_i in T_east:
-            res = poisson_bc1_bc1_nonlin_fvm1(
-                T=None, 
-                L=L, 
-                n_vol=n_vol, 
-                T_west=T_west_i, 
-                T_east=T_east_i, 
-                conductivity=conductivity, 
-                source=None,
-                mse=mse,
-                silent=silent)
-            dqdt_west.append(res['dqdt_west'])
-            dqdt_east.append(res['dqdt_east'])
-            
-            if not silent: 
-                plt.plot(res['x'] * plot_scale[0][0], 
-                         res['T'] * plot_scale[1][0], label='T_w/T_e: ' 
-                         + str((T_west_i, T_east_i)) + r'  $\dot q:$' 
-                         + str((int(res['dqdt_west']), int(res['dqdt_east']))))
-        if not silent:
-            plt.xlabel('x [' + plot_scale[0][1] + ']')
-            plt.ylabel('T [' + plot_scale[1][1] + ']')
-            plt.legend(); plt.grid(); plt.show()
+    # combinations in output order: T_west (outer loop), T_east (inner loop)
+    pairs = [(T_west_i, T_east_i) for T_west_i in T_west 
+                                  for T_east_i in T_east]
+    if n_jobs is None:
+        n_jobs = os.cpu_count() or 1
+    n_jobs = max(1, min(n_jobs, len(pairs)))
+    if chunk_size is None:
+        n_chunks = n_jobs if batched else 4 * n_jobs
+        chunk_size = max(1, int(np.ceil(len(pairs) / n_chunks)))
+    chunks = [pairs[i:i+chunk_size] for i in range(0, len(pairs), 
+                                                    chunk_size)]
+    if mesh is not None:
+        # faces are generated once and shared by all chunks
+        mesh = _fvm1_vertices(L, n_vol, mesh)
+    args = (k_coeff, T_ref, L, n_vol, mse, method, warm_start, mesh)
+    solve = _dqdt_for_bc1_batch if batched else _dqdt_for_bc1_chunk
+
+    if n_jobs == 1:
+        plot = not silent
+        results = []
+        for chunk in chunks:
+            results += solve(chunk, *args, return_solutions=plot)
+    else:
+        plot = False
+        Executor = ProcessPoolExecutor if executor == 'process' \
+            else ThreadPoolExecutor
+        with Executor(max_workers=n_jobs) as pool:
+            results = [r for chunk_results in pool.map(solve, chunks, 
+                           *[[a] * len(chunks) for a in args])
+                       for r in chunk_results]
+
+    dqdt_west = [r[0] for r in results]
+    dqdt_east = [r[1] for r in results]
+
+    if plot:
+        x, _ = _fvm1_mesh(L, n_vol, mesh)
+        for j, ((T_west_i, T_east_i), (q_w, q_e, T)) in \
+                enumerate(zip(pairs, results)):
+            plt.plot(x * plot_scale[0][0], T * plot_scale[1][0], 
+                     label='T_w/T_e: ' + str((T_west_i, T_east_i)) + 
+                     r'  $\dot q:$' + str((int(q_w), int(q_e))))
+            if (j + 1) % T_east.size == 0:
+                plt.xlabel('x [' + plot_scale[0][1] + ']')
+                plt.ylabel('T [' + plot_scale[1][1] + ']')
+                plt.legend(); plt.grid(); plt.show()
 
     return np.asfarray(dqdt_west), np.asfarray(dqdt_east)
 
 
-dqdt_for_bc1_seq()
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    dqdt_for_bc1_seq()
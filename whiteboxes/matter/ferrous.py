@@ -43,11 +43,11 @@ class St1_4016(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0., p=0., x=0.: 220e+9
-        self.beta.calc    = lambda T=0., p=0., x=0.: 10.5e-6
-        self.c_p.calc     = lambda T=0., p=0., x=0.: 460.
-        self.k.calc       = lambda T=0., p=0., x=0.: 25.
-        self.rho.calc     = lambda T=0., p=0., x=0.: 7700.
+        self.E.calc       = 220e+9
+        self.beta.calc    = 10.5e-6
+        self.c_p.calc     = 460.
+        self.k.calc       = 25.
+        self.rho.calc     = 7700.
 
 
 class St1_4003(Ferrous):
@@ -55,11 +55,11 @@ class St1_4003(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0., p=0., x=0.: 220e+9
-        self.beta.calc    = lambda T=0., p=0., x=0.: 11.6e-6
-        self.c_p.calc     = lambda T=0., p=0., x=0.: 430.
-        self.k.calc       = lambda T=0., p=0., x=0.: 25.
-        self.rho.calc     = lambda T=0., p=0., x=0.: 7700.
+        self.E.calc       = 220e+9
+        self.beta.calc    = 11.6e-6
+        self.c_p.calc     = 430.
+        self.k.calc       = 25.
+        self.rho.calc     = 7700.
 
 
 class St1_4301(Ferrous):
@@ -68,11 +68,11 @@ class St1_4301(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = C2K(1400)
-        self.E.calc       = lambda T=0., p=0., x=0.: 200e+9
-        self.beta.calc    = lambda T=0., p=0., x=0.: 17.5e-6
-        self.c_p.calc     = lambda T=0., p=0., x=0.: 500.
-        self.k.calc       = lambda T=0., p=0., x=0.: 15.
-        self.rho.calc     = lambda T=0., p=0., x=0.: 7900.
+        self.E.calc       = 200e+9
+        self.beta.calc    = 17.5e-6
+        self.c_p.calc     = 500.
+        self.k.calc       = 15.
+        self.rho.calc     = 7900.
 
 
 class St1_4541(Ferrous):
@@ -81,11 +81,11 @@ class St1_4541(Ferrous):
         super().__init__(identifier, latex=latex, comment=None)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0., p=0., x=0.: 200e+9
-        self.beta.calc    = lambda T=0., p=0., x=0.: 17.5e-6
-        self.c_p.calc     = lambda T=0., p=0., x=0.: 500.
-        self.k.calc       = lambda T=0., p=0., x=0.: 15.
-        self.rho.calc     = lambda T=0., p=0., x=0.: 7900.
+        self.E.calc       = 200e+9
+        self.beta.calc    = 17.5e-6
+        self.c_p.calc     = 500.
+        self.k.calc       = 15.
+        self.rho.calc     = 7900.
 
 
 class St1_4401(Ferrous):
@@ -94,11 +94,11 @@ class St1_4401(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0., p=0., x=0.: 200e+9
-        self.beta.calc    = lambda T=0., p=0., x=0.: 17.5e-6
-        self.c_p.calc     = lambda T=0., p=0., x=0.: 500.
-        self.k.calc       = lambda T=0., p=0., x=0.: 15.
-        self.rho.calc     = lambda T=0., p=0., x=0.: 8000.
+        self.E.calc       = 200e+9
+        self.beta.calc    = 17.5e-6
+        self.c_p.calc     = 500.
+        self.k.calc       = 15.
+        self.rho.calc     = 8000.
 
 
 class St1_4571(Ferrous):
@@ -107,11 +107,11 @@ class St1_4571(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0, p=0, x=0: 200e+9
-        self.beta.calc    = lambda T=0, p=0, x=0: 18.5e-6
-        self.c_p.calc     = lambda T=0, p=0, x=0: 500
-        self.k.calc       = lambda T=0, p=0, x=0: 15
-        self.rho.calc     = lambda T=0, p=0, x=0: 8000
+        self.E.calc       = 200e+9
+        self.beta.calc    = 18.5e-6
+        self.c_p.calc     = 500
+        self.k.calc       = 15
+        self.rho.calc     = 8000
 
 
 class St1_4362(Ferrous):
@@ -119,11 +119,11 @@ class St1_4362(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0, p=0, x=0: 200e+9
-        self.beta.calc    = lambda T=0, p=0, x=0: 17.5e-6
-        self.c_p.calc     = lambda T=0, p=0, x=0: 500.
-        self.k.calc       = lambda T=0, p=0, x=0: 15.
-        self.rho.calc     = lambda T=0, p=0, x=0: 7800.
+        self.E.calc       = 200e+9
+        self.beta.calc    = 17.5e-6
+        self.c_p.calc     = 500.
+        self.k.calc       = 15.
+        self.rho.calc     = 7800.
 
 
 class St1_4462(Ferrous):
@@ -132,11 +132,11 @@ class St1_4462(Ferrous):
         super().__init__(identifier, latex=latex, comment=comment)
         self.T.ref = C2K(20)
         self.T_sol = None
-        self.E.calc       = lambda T=0, p=0, x=0: 200e+9
-        self.beta.calc    = lambda T=0, p=0, x=0: 14.5e-6
-        self.c_p.calc     = lambda T=0, p=0, x=0: 500.
-        self.k.calc       = lambda T=0, p=0, x=0: 15.
-        self.rho.calc     = lambda T=0, p=0, x=0: 7800.
+        self.E.calc       = 200e+9
+        self.beta.calc    = 14.5e-6
+        self.c_p.calc     = 500.
+        self.k.calc       = 15.
+        self.rho.calc     = 7800.
         
         
 class Iron(Ferrous, Liquid):
@@ -173,7 +173,7 @@ class Iron(Ferrous, Liquid):
 
         self.nu_mech       = None
         self.friction      = None
-        self.E.calc        = lambda T=0, p=0, x=0: 211e9
+        self.E.calc        = 211e9
 
         self.T_sol         = C2K(1430)
         self.T_liq         = self.T_sol + 50
@@ -181,18 +181,24 @@ class Iron(Ferrous, Liquid):
         self.T_deform      = self.T_sol + 0.66 * (self.T_liq - self.T_sol)
         self.h_melt        = 270e+3
         self.h_vap         = 6.35e+6
-        self.beta.calc     = lambda T=0, p=0, x=0: 23.1e-6
+        self.beta.calc     = 23.1e-6
         self.work_function = 4.3         # JAP Vol6 1973 p.2250 [QUIG73]
 
         self.c_p.calc      = self._c_p
         self.k.calc        = self._k
-        self.M.calc        = lambda T=0, p=0, x=0: 55.845e-3
+        self.M.calc        = 55.845e-3
         self.mu.calc       = self._mu
         self.nu.calc       = lambda T=0, p=0, x=0: self.mu(T, p, x) / \
                                                   self.rho(T, p, x)
         self.rho.calc      = self._rho
         self.rho_el.calc   = self._rho_el
 
+        # vectorized kernels, see Property.eval_batch()
+        self.c_p.calc_vec  = self._c_p
+        self.k.calc_vec    = self._k
+        self.mu.calc_vec   = self._mu_vec
+        self.rho.calc_vec  = self._rho_vec
+
     def _c_p(self, T: float = C2K(20), p: float = atm(), 
              x: float = 0.) -> float:
         Tp = [300, 600, 900, 1033, 1040, 1184, 1184.1, 1400, 1673, 1673.1,
@@ -217,6 +223,13 @@ class Iron(Ferrous, Liquid):
         return 0.3699e-3 * np.exp(41.4e3 / (8.3144*T)) \
             if T > self.T_deform else 1e20
 
+    def _mu_vec(self, T: np.ndarray, p: np.ndarray, 
+                x: np.ndarray) -> np.ndarray:
+        T = np.asfarray(T)
+        T_safe = np.where(T > self.T_deform, T, self.T_deform + 1.)
+        return np.where(T > self.T_deform, 
+                        0.3699e-3 * np.exp(41.4e3 / (8.3144*T_safe)), 1e20)
+
     def _rho(self, T: float = C2K(20), p: float = atm(), 
              x: float = 0.) -> float:
         """
@@ -232,6 +245,15 @@ class Iron(Ferrous, Liquid):
             rho = (-1e-4 * T_Celsius - 0.3) * T_Celsius + 7849.1
         return rho
 
+    def _rho_vec(self, T: np.ndarray, p: np.ndarray, 
+                 x: np.ndarray) -> np.ndarray:
+        T_Celsius = np.minimum(K2C(T), 1600)
+        return np.select(
+            [T_Celsius > 1536, T_Celsius > 723],
+            [7030 + (-8.8e-1) * (T_Celsius - 1536),
+             (-1e-4 * T_Celsius - 0.2) * T_Celsius + 7852.3],
+            (-1e-4 * T_Celsius - 0.3) * T_Celsius + 7849.1)
+
     def _rho_el(self, T: float = C2K(20), p: float = atm(), 
                 x: float = 0.) -> float:
         """
@@ -25,6 +25,7 @@
 
 import numpy as np
 import sys
+from typing import Dict, Iterable, Optional, Tuple
 
 from conversion import atm, C2K
 from gasmix import GasMix
@@ -32,6 +33,8 @@ from importpack import import_package
 from matter import Gas
 # from mixformulas import mass_to_mole_fractions
 from range import Range
+from tabulated import PropertyTable
+from whiteboxes.tools import telemetry
 
 try:
     import CoolProp
@@ -82,6 +85,137 @@ class _GenericCP(Gas):
         self.mu.calc = self._mu
         self.rho.calc = self._rho
 
+        # vectorized kernels, see Property.eval_batch()
+        self.c_sound.calc_vec = lambda T, p, x: self._props_vec('A', T, p)
+        self.c_p.calc_vec = lambda T, p, x: self._props_vec('C', T, p)
+        self.k.calc_vec = lambda T, p, x: self._props_vec('conductivity', 
+                                                          T, p)
+        self.mu.calc_vec = lambda T, p, x: self._props_vec('viscosity', T, p)
+        self.rho.calc_vec = lambda T, p, x: self._props_vec('Dmass', T, p)
+
+        # optional lookup tables, see tabulate()
+        self._tables: Dict[str, PropertyTable] = {}
+
+        # CoolProp state object, created at first call of state()
+        self._abstract_state = None
+
+    def state(self, T: float, p: float = atm(), 
+              x: float = 0.) -> Dict[str, float | None]:
+        """
+        Evaluates all transport and thermodynamic properties with a 
+        single equation-of-state solution
+        
+        Args:
+            T:
+                temperature [K]
+            p:
+                pressure [Pa]
+            x:
+                dummy parameter [/]
+
+        Returns:
+            dictionary with keys 'rho', 'c_p', 'k', 'mu', 'M' and 
+            'c_sound'. Values are None if parameters are out of range
+
+        Note:
+            One CoolProp AbstractState is created per instance and 
+            updated once per call. Lookup tables of tabulate() are not
+            employed
+        """
+        keys = ('rho', 'c_p', 'k', 'mu', 'M', 'c_sound')
+        try:
+            if self._abstract_state is None:
+                self._abstract_state = CoolProp.AbstractState('HEOS', 
+                    self.identifier)
+            cp_state = self._abstract_state
+            telemetry.count('coolprop')
+            cp_state.update(CoolProp.PT_INPUTS, p, T)
+            return {'rho': cp_state.rhomass(), 
+                    'c_p': cp_state.cpmass(), 
+                    'k': cp_state.conductivity(), 
+                    'mu': cp_state.viscosity(), 
+                    'M': cp_state.molar_mass(), 
+                    'c_sound': cp_state.speed_sound()}
+        except Exception:
+            return {key: None for key in keys}
+
+    def _props_vec(self, key: str, T: np.ndarray, 
+                   p: np.ndarray) -> np.ndarray:
+        """
+        Args:
+            key:
+                CoolProp output key, e.g. 'C' or 'Dmass'
+            T:
+                array of temperatures [K]
+            p:
+                array of pressures [Pa]
+
+        Returns:
+            property values, shape of broadcast T and p
+
+        Note:
+            CoolProp raises an exception if any point is invalid. Then
+            Property.eval_batch() falls back to element-wise evaluation
+        """
+        T, p = np.broadcast_arrays(np.asfarray(T), np.asfarray(p))
+        telemetry.count('coolprop', T.size)
+        y = CoolProp.CoolProp.PropsSI(key, 'T', T.ravel(), 'P', p.ravel(),
+                                      self.identifier)
+        return np.reshape(y, T.shape)
+
+    def tabulate(self, keys: Iterable[str] = ('c_p', 'c_sound', 'k', 'mu',
+                                              'rho'),
+                 tol: float = 1e-4,
+                 degree: int = 3,
+                 path: str | None = None,
+                 silent: bool = True) -> Dict[str, PropertyTable]:
+        """
+        Replaces CoolProp calls of properties by lookup tables over the
+        'operational' range of T and p. The tables are built lazily at
+        the first property call and persisted, see PropertyTable
+
+        Args:
+            keys:
+                identifiers of properties to be tabulated
+
+            tol:
+                upper bound of relative interpolation error [/]
+
+            degree:
+                degree of spline: 3 (bicubic) or 1 (bilinear, monotone)
+
+            path:
+                directory of table files. If None, temporary directory 
+                is used. If path is '', the tables are not persisted
+
+            silent:
+                if False, then build and load of tables are reported
+
+        Returns:
+            dictionary of tables, achieved error: tables[key].max_rel_error
+
+        Example:
+            gas = CO2()
+            tables = gas.tabulate(tol=1e-5)
+            c_p = gas.c_p(T=C2K(100), p=5e5)  # first call builds table
+            print(tables['c_p'])
+        """
+        T_op, p_op = self.T['operational'], self.p['operational']
+        for key in keys:
+            prop = getattr(self, key)
+            if key in self._tables:                   # restore exact calc
+                prop.calc = self._tables[key].func
+                prop.calc_vec = self._tables[key].func_vec
+            table = PropertyTable(prop.calc, (T_op.lo, T_op.up),
+                                  (p_op.lo, p_op.up),
+                                  identifier=self.identifier + '_' + key,
+                                  func_vec=prop.calc_vec, tol=tol,
+                                  degree=degree, path=path, silent=silent)
+            prop.calc = table
+            prop.calc_vec = table.evaluate
+            self._tables[key] = table
+        return dict(self._tables)
+
     def _c_p(self, T: float, p: float = atm(), x: float = 0.) -> float | None:
         """
         Args:
@@ -98,6 +232,7 @@ class _GenericCP(Gas):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.PropsSI('C', 'T', T, 'P', p,
                                              self.identifier)
         except:
@@ -119,6 +254,7 @@ class _GenericCP(Gas):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.PropsSI('Dmass', 'T', T, 'P', p,
                                              self.identifier)
         except:
@@ -140,6 +276,7 @@ class _GenericCP(Gas):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.PropsSI('conductivity', 'T', T, 'P', p,
                                              self.identifier)
         except:
@@ -163,6 +300,7 @@ class _GenericCP(Gas):
             All arguments of this method are dummy parameters
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.PropsSI('molemass', self.identifier)
         except:
             return None
@@ -186,6 +324,7 @@ class _GenericCP(Gas):
             kinematic viscosity: nu = mu / rho
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.PropsSI('viscosity', 'T', T, 'P', p,
                                              self.identifier)
         except:
@@ -208,6 +347,7 @@ class _GenericCP(Gas):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.PropsSI('A', 'T', T, 'P', p,
                                              self.identifier)
         except:
@@ -238,6 +378,85 @@ class StandardAir(GasMix):
         self.fill_up(N2)
 
 
+# ratio of molar masses of water and dry air [/]
+M_RATIO_WATER_AIR = 18.015268 / 28.966
+
+# specific gas constant of dry air [J/kg/K]
+R_DRY_AIR = 287.042
+
+# enhancement factor of saturation pressure in moist air [/]
+ENHANCEMENT_FACTOR = 1.0044
+
+# coefficients of ln(p_ws) over ice (T < 273.15 K) and over liquid water
+_HW_ICE = (-5.6745359e3, 6.3925247, -9.6778430e-3, 6.2215701e-7,
+           2.0747825e-9, -9.4840240e-13, 4.1635019)
+_HW_WATER = (-5.8002206e3, 1.3914993, -4.8640239e-2, 4.1764768e-5,
+             -1.4452093e-8, 0., 6.5459673)
+
+
+def ln_saturation_pressure(T: np.ndarray) -> Tuple[np.ndarray, np.ndarray]:
+    """
+    Vectorized kernel of saturation pressure of water vapor after 
+    Hyland and Wexler, valid from 173.15 K to 473.15 K
+
+    Args:
+        T:
+            temperature [K], array
+
+    Returns:
+        ln(p_ws) with p_ws in [Pa] and d ln(p_ws) / dT [1/K], arrays of 
+        shape of T
+
+    Reference:
+        ASHRAE Handbook Fundamentals 2017, ch. 1, equ. (5) and (6)
+    """
+    T = np.asfarray(T)
+    ice = T < 273.15
+    c1, c2, c3, c4, c5, c6, c7 = (np.where(ice, a, b) 
+                                  for a, b in zip(_HW_ICE, _HW_WATER))
+    ln_p = c1 / T + c2 + T * (c3 + T * (c4 + T * (c5 + T * c6))) + \
+        c7 * np.log(T)
+    dln_p = -c1 / T**2 + c3 + T * (2. * c4 + T * (3. * c5 + T * 4. * c6)) + \
+        c7 / T
+    return ln_p, dln_p
+
+
+def saturation_pressure(T: np.ndarray) -> np.ndarray:
+    """
+    Saturation pressure of water vapor, see ln_saturation_pressure()
+
+    Args:
+        T:
+            temperature [K], float or array
+
+    Returns:
+        saturation pressure p_ws [Pa]
+    """
+    return np.exp(ln_saturation_pressure(T)[0])
+
+
+def _dew_point(p_w: np.ndarray, n_newton: int = 8) -> np.ndarray:
+    """
+    Inverse of saturation_pressure(), Newton iterations seeded by
+    Magnus formula
+
+    Args:
+        p_w:
+            partial pressure of water vapor [Pa], array
+
+    Returns:
+        dew point temperatures (T_dew) [K], NaN if p_w <= 0
+    """
+    with np.errstate(divide='ignore', invalid='ignore'):
+        ln_target = np.log(p_w)
+        z = ln_target - np.log(610.94)
+        T = 273.15 + 243.04 * z / (17.625 - z)
+        for _ in range(n_newton):
+            ln_p, dln_p = ln_saturation_pressure(T)
+            T = T - (ln_p - ln_target) / dln_p
+    return T
+
+
 class HumidAir(_GenericCP):
     """
     Properties of humid air from CoolProp library
@@ -255,6 +474,27 @@ class HumidAir(_GenericCP):
                  comment: str | None = None) -> None:
         super().__init__(identifier=identifier, latex=latex, comment=comment)
 
+        # pure-fluid kernels of parent class are not valid for humid air
+        for prop in (self.c_sound, self.c_p, self.k, self.mu, self.rho):
+            prop.calc_vec = None
+
+    def tabulate(self, *args, **kwargs) -> Dict[str, PropertyTable]:
+        """
+        Raises:
+            NotImplementedError: properties depend on humidity 'x', but
+            tables of PropertyTable are functions of T and p only
+        """
+        raise NotImplementedError('HumidAir: tables of T, p and x')
+
+    def state(self, T: float, p: float = atm(), 
+              x: float = 0.) -> Dict[str, float | None]:
+        """
+        Same as _GenericCP.state(), but properties are called separately 
+        because the HEOS backend does not cover humid air
+        """
+        return {key: getattr(self, key)(T, p, x) 
+                for key in ('rho', 'c_p', 'k', 'mu', 'M', 'c_sound')}
+
     def _M(self, T: float, p: float = atm(), x: float = 0.) -> float | None:
         """
         Args:
@@ -348,6 +588,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('HumRat', 'T', T, 'P', p,
                                                'RH', RH)
         except:
@@ -373,6 +614,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('psi_w', 'T', T, 'P', p,
                                                'RH', RH)
         except:
@@ -397,6 +639,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('RH', 'T', T, 'P', p,
                                                'psi_w', y)
         except:
@@ -516,6 +759,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('W', 'T', T, 'P', p, 'RH', RH)
         except:
             return None
@@ -539,6 +783,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('RH', 'T', T, 'P', p,
                                                'psi_w', y)
         except:
@@ -563,7 +808,12 @@ class HumidAir(_GenericCP):
             OR
             None if parameters out of range
         """
-        return self.humidity_ratio(T, p, RH=y)
+        try:
+            telemetry.count('coolprop')
+            return CoolProp.CoolProp.HAPropsSI('W', 'T', T, 'P', p, 
+                                               'psi_w', y)
+        except:
+            return None
 
     def W_to_RH(self, T: float, p: float = atm(),
                 W: float = 0.) -> float | None:
@@ -586,6 +836,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('RH', 'T', T, 'P', p,
                                                'HumRat', W)
         except:
@@ -612,6 +863,7 @@ class HumidAir(_GenericCP):
             None if parameters out of range
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('psi_w', 'T', T, 'P', p,
                                                'HumRat', W)
         except:
@@ -653,6 +905,252 @@ class HumidAir(_GenericCP):
         except:
             return None
 
+    # array-native psychrometrics, see psychrometrics()
+
+    def psychrometrics(self, T: float | Iterable[float], 
+                       p: float | Iterable[float] = atm(),
+                       RH: Optional[float | Iterable[float]] = None,
+                       W: Optional[float | Iterable[float]] = None,
+                       y: Optional[float | Iterable[float]] = None,
+                       T_dew: Optional[float | Iterable[float]] = None,
+                       dew_point: bool = False) -> Dict[str, np.ndarray]:
+        """
+        Converts one humidity measure to all others for arrays of states.
+        The saturation pressure is evaluated once per call in a 
+        vectorized kernel, see saturation_pressure()
+
+        Args:
+            T:
+                air temperature [K]
+            p:
+                pressure [Pa]
+            RH, W, y, T_dew:
+                exactly one of: relative humidity [/], humidity ratio 
+                [kg/kg_dry_air], water mole fraction [mol/mol_humid_air] or
+                dew point temperature [K]
+            dew_point:
+                if True, then dew point temperature is computed, it is
+                always returned if T_dew is given
+
+        Returns:
+            dictionary of arrays of broadcast shape of arguments:
+                'RH', 'W', 'y', 'AH' [kg/m3_dry_air], 'p_ws' [Pa], 
+                'T_dew' (optional) and 'valid' (bool). Invalid elements 
+                are NaN
+
+        Note:
+            Ideal mixture of ideal gases with constant enhancement factor,
+            values are close to those of the CoolProp-based scalar methods
+            in the range 230 K < T < 370 K. The state is invalid if RH is
+            outside of [0, 1], T is outside of the range of the saturation
+            pressure kernel or if p <= 0
+        """
+        given = [(key, val) for key, val in 
+                 (('RH', RH), ('W', W), ('y', y), ('T_dew', T_dew)) 
+                 if val is not None]
+        assert len(given) == 1, 'exactly one of RH, W, y and T_dew'
+        key, val = given[0]
+        T, p, val = np.broadcast_arrays(np.asfarray(T), np.asfarray(p), 
+                                        np.asfarray(val))
+
+        f = ENHANCEMENT_FACTOR
+        p_ws = saturation_pressure(T)
+        with np.errstate(divide='ignore', invalid='ignore'):
+            if key == 'RH':
+                y_ = val * f * p_ws / p
+            elif key == 'W':
+                y_ = val / (M_RATIO_WATER_AIR + val)
+            elif key == 'y':
+                y_ = np.array(val)
+            else:
+                y_ = f * saturation_pressure(val) / p
+            RH_ = y_ * p / (f * p_ws)
+            W_ = M_RATIO_WATER_AIR * y_ / (1. - y_)
+            AH_ = W_ * p / (R_DRY_AIR * T)
+
+        valid = (T >= 173.15) & (T <= 473.15) & (p > 0.) & \
+            (RH_ >= 0.) & (RH_ <= 1. + 1e-12) & np.isfinite(W_)
+        result = {'RH': RH_, 'W': W_, 'y': y_, 'AH': AH_, 'p_ws': p_ws}
+        if dew_point or key == 'T_dew':
+            result['T_dew'] = np.array(val) if key == 'T_dew' else \
+                _dew_point(y_ * p / f)
+        for x in result.values():
+            x[~valid] = np.nan
+        result['valid'] = valid
+
+        return result
+
+    def _convert_vec(self, T: float | Iterable[float], 
+                     p: float | Iterable[float], 
+                     dst: str, **src: float | Iterable[float]) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Returns:
+            converted humidity measure 'dst' and validity mask, 
+            see psychrometrics()
+        """
+        state = self.psychrometrics(T, p, dew_point=dst == 'T_dew', **src)
+        return state[dst], state['valid']
+
+    def RH_to_W_vec(self, T: float | Iterable[float], 
+                    p: float | Iterable[float] = atm(),
+                    RH: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of RH_to_W(), see psychrometrics()
+
+        Returns:
+            humidity ratio (W) [kg/kg_dry_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'W', RH=RH)
+
+    humidity_ratio_vec = RH_to_W_vec
+
+    def RH_to_y_vec(self, T: float | Iterable[float], 
+                    p: float | Iterable[float] = atm(),
+                    RH: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of RH_to_y(), see psychrometrics()
+
+        Returns:
+            water mole fraction (y) [mol/mol_humid_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'y', RH=RH)
+
+    mole_fraction_vec = RH_to_y_vec
+
+    def RH_to_AH_vec(self, T: float | Iterable[float], 
+                     p: float | Iterable[float] = atm(),
+                     RH: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of RH_to_AH(), see psychrometrics()
+
+        Returns:
+            absolute humidity (AH) [kg/m3_dry_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'AH', RH=RH)
+
+    def W_to_RH_vec(self, T: float | Iterable[float], 
+                    p: float | Iterable[float] = atm(),
+                    W: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of W_to_RH(), see psychrometrics()
+
+        Returns:
+            relative humidity (RH) [/] and validity mask
+        """
+        return self._convert_vec(T, p, 'RH', W=W)
+
+    def W_to_y_vec(self, T: float | Iterable[float], 
+                   p: float | Iterable[float] = atm(),
+                   W: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of W_to_y(), see psychrometrics()
+
+        Returns:
+            water mole fraction (y) [mol/mol_humid_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'y', W=W)
+
+    def W_to_AH_vec(self, T: float | Iterable[float], 
+                    p: float | Iterable[float] = atm(),
+                    W: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of W_to_AH(), see psychrometrics()
+
+        Returns:
+            absolute humidity (AH) [kg/m3_dry_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'AH', W=W)
+
+    def y_to_RH_vec(self, T: float | Iterable[float], 
+                    p: float | Iterable[float] = atm(),
+                    y: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of y_to_RH(), see psychrometrics()
+
+        Returns:
+            relative humidity (RH) [/] and validity mask
+        """
+        return self._convert_vec(T, p, 'RH', y=y)
+
+    relative_humidity_vec = y_to_RH_vec
+
+    def y_to_W_vec(self, T: float | Iterable[float], 
+                   p: float | Iterable[float] = atm(),
+                   y: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of y_to_W(), see psychrometrics()
+
+        Returns:
+            humidity ratio (W) [kg/kg_dry_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'W', y=y)
+
+    def y_to_AH_vec(self, T: float | Iterable[float], 
+                    p: float | Iterable[float] = atm(),
+                    y: float | Iterable[float] = 0.) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of y_to_AH(), see psychrometrics()
+
+        Returns:
+            absolute humidity (AH) [kg/m3_dry_air] and validity mask
+        """
+        return self._convert_vec(T, p, 'AH', y=y)
+
+    def T_and_T_dew_to_RH_vec(self, T: float | Iterable[float], 
+                              T_dew: float | Iterable[float]) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of T_and_T_dew_to_RH() with Hyland-Wexler instead
+        of Magnus formula: RH = p_ws(T_dew) / p_ws(T)
+
+        Returns:
+            relative humidity (RH) [/] and validity mask
+        """
+        return self._convert_vec(T, atm(), 'RH', T_dew=T_dew)
+
+    def T_and_RH_to_T_dew_vec(self, T: float | Iterable[float], 
+                              RH: float | Iterable[float]) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of T_and_RH_to_T_dew() with Hyland-Wexler instead
+        of Magnus formula
+
+        Returns:
+            dew point temperature (T_dew) [K] and validity mask
+        """
+        return self._convert_vec(T, atm(), 'T_dew', RH=RH)
+
+    def RH1_to_RH2_vec(self, RH1: float | Iterable[float], 
+                       T1: float | Iterable[float], 
+                       T2: float | Iterable[float],
+                       p1: float | Iterable[float] = atm(), 
+                       p2: Optional[float | Iterable[float]] = None) \
+            -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Array version of RH1_to_RH2(): converts relative humidity from 
+        RH(T1, p1) to RH(T2, p2) at constant humidity ratio W
+
+        Returns:
+            relative humidity at (T2, p2) [/] and validity mask; 
+            invalid if RH1 or RH2 is outside of [0, 1]
+        """
+        if p2 is None:
+            p2 = p1
+        state1 = self.psychrometrics(T1, p1, RH=RH1)
+        state2 = self.psychrometrics(T2, p2, y=state1['y'])
+        valid = state1['valid'] & state2['valid']
+        return np.where(valid, state2['RH'], np.nan), valid
+
     def _c_p(self, T: float, p: float = atm(),
              x: float = 0.) -> float | None:
         """
@@ -668,6 +1166,7 @@ class HumidAir(_GenericCP):
             Specific heat capacity [J/kg/K]
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('cp_ha', 'T', T, 'P', p,
                                                'RH', x)
         except:
@@ -692,6 +1191,7 @@ class HumidAir(_GenericCP):
             air in [m3/kg] -> density is inverse value
         """
         try:
+            telemetry.count('coolprop')
             return 1. / CoolProp.CoolProp.HAPropsSI('Vha', 'T', T, 'P', p,
                                                     'RH', x)
         except:
@@ -711,6 +1211,7 @@ class HumidAir(_GenericCP):
             thermal conductivity [W/m/K]
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('k', 'T', T, 'P', p, 'RH', x)
         except:
             return None
@@ -729,6 +1230,7 @@ class HumidAir(_GenericCP):
             dynamic viscosity [Pa s]
         """
         try:
+            telemetry.count('coolprop')
             return CoolProp.CoolProp.HAPropsSI('mu', 'T', T, 'P', p, 'RH', x)
         except:
             return None
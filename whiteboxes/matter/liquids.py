@@ -22,7 +22,16 @@
 
 import numpy as np
 from scipy.interpolate import interp2d
-from typing import Optional
+from typing import Dict, Optional, Tuple, Union
+
+try:
+    from numba import jit
+except ImportError:
+    def jit(*args, **kwargs):
+        # no-op decorator, the water kernels run interpreted
+        if len(args) == 1 and callable(args[0]) and not kwargs:
+            return args[0]
+        return lambda func: func
 
 try:
     from conversion import C2K, K2C
@@ -189,6 +198,82 @@ class HydraulicOil(Liquid):
         return f(T, p)
 
 
+# order of properties in rows of output of water_state_kernel()
+WATER_STATE_KEYS = ('rho', 'nu', 'mu', 'c_p', 'k', 'c_sound')
+
+
+@jit(nopython=True, cache=True)
+def _water_state_point(T: float, p: float, p_ref: float, E: float, 
+                       T_liq: float, T_boil: float) \
+        -> Tuple[float, float, float, float, float, float]:
+    # density, see Water._rho(); E <= 0: incompressible
+    T_C = T - 273.15
+    d = T_C - 3.9863
+    rho = 1e3 * (1. - (T_C + 288.9414) / (508929. * (T_C + 68.129630)) * d*d)
+    if E > 0.:
+        rho /= 1. - (p - p_ref) / max(E, 1e-20)
+
+    # dynamic and kinematic viscosity, see Water._mu() and Water._nu()
+    mu = 2.414e-5 * 10. ** (247.8 / (T - 140.))
+    nu = mu / rho
+
+    # heat capacity, see Water._c_p()
+    if T < T_liq:
+        c_p = 2108.
+    elif T < T_boil:
+        c_p = 1e3 * (28.07 + T * (-0.2817 + T * (1.25e-3 +
+                     T * (-2.48e-6 + T * 1.857e-9))))
+    else:
+        c_p = 1996.
+
+    k = -0.5752 + T * (6.397e-3 - T * 8.151e-6)
+    c_sound = 20.05 * np.sqrt(T)
+
+    return rho, nu, mu, c_p, k, c_sound
+
+
+# compiled point evaluation, can be called from other @jit functions
+water_state_point = _water_state_point
+
+
+@jit(nopython=True, cache=True)
+def water_state_kernel(T: np.ndarray, p: np.ndarray, p_ref: float, 
+                       E: float, T_liq: float, T_boil: float, 
+                       out: np.ndarray) -> np.ndarray:
+    """
+    Fused evaluation of all water properties in one pass over the
+    elements, see Water.state()
+
+    Args:
+        T:
+            temperatures [K], 1D array
+        p:
+            pressures [Pa], 1D array of same size as T
+        p_ref:
+            reference pressure of compressibility correction [Pa]
+        E:
+            constant compression modulus [Pa], E <= 0: incompressible
+        T_liq, T_boil:
+            temperatures of melting and boiling [K]
+        out:
+            result array of shape (len(WATER_STATE_KEYS), T.size), rows 
+            in order of WATER_STATE_KEYS
+
+    Returns:
+        out
+    """
+    for i in range(T.size):
+        rho, nu, mu, c_p, k, c_sound = _water_state_point(
+            T[i], p[i], p_ref, E, T_liq, T_boil)
+        out[0, i] = rho
+        out[1, i] = nu
+        out[2, i] = mu
+        out[3, i] = c_p
+        out[4, i] = k
+        out[5, i] = c_sound
+    return out
+
+
 class Water(Liquid):
     """
     Physical and chemical properties of water
@@ -236,6 +321,70 @@ class Water(Liquid):
         self.c_sound.calc = self._c_sound
         self.E.calc       = self._E
 
+        # vectorized kernels, see Property.eval_batch()
+        self.rho.calc_vec     = self._rho
+        self.nu.calc_vec      = self._nu
+        self.mu.calc_vec      = self._mu
+        self.c_p.calc_vec     = self._c_p_vec
+        self.k.calc_vec       = self._k
+        self.c_sound.calc_vec = self._c_sound
+
+        # analytic gradients, see Property.grad()
+        self.rho.calc_grad = self._rho_grad
+
+    def kernel_args(self) -> Tuple[float, float, float, float]:
+        """
+        Returns:
+            constant arguments (p_ref, E, T_liq, T_boil) of 
+            water_state_kernel() and water_state_point() for this matter
+        """
+        p_ref = 0. if self.rho.p.absolute else self.p.ref
+        E = self.E()
+        E = float(E) if E else 0.
+
+        return float(p_ref), E, float(self.T_liq), float(self.T_boil)
+
+    def state(self, T: Union[float, np.ndarray], 
+              p: Optional[Union[float, np.ndarray]] = None,
+              x: float = 0.) -> Dict[str, Union[float, np.ndarray]]:
+        """
+        Computes rho, nu, mu, c_p, k and c_sound in one compiled pass 
+        over all elements, with temperature conversion and fits shared 
+        between the properties
+
+        Args:
+            T:
+                temperature [K]
+            p:
+                pressure [Pa]. If None, p.ref is used
+            x:
+                dummy parameter [/]
+
+        Returns:
+            dictionary of properties with keys of WATER_STATE_KEYS and
+            value of E; floats if T and p are scalars, otherwise arrays 
+            of broadcast shape of T and p
+
+        Note:
+            Compiled engines call water_state_kernel() or 
+            water_state_point() with the arguments of kernel_args()
+        """
+        if p is None:
+            p = self.p.ref
+        scalar = np.ndim(T) == 0 and np.ndim(p) == 0
+        T, p = np.broadcast_arrays(np.asfarray(T), np.asfarray(p))
+        shape = T.shape
+        out = np.empty((len(WATER_STATE_KEYS), T.size))
+        p_ref, E, T_liq, T_boil = self.kernel_args()
+        water_state_kernel(np.ascontiguousarray(T).ravel(), 
+                           np.ascontiguousarray(p).ravel(), p_ref, E, 
+                           T_liq, T_boil, out)
+
+        result = {key: float(row[0]) if scalar else row.reshape(shape)
+                  for key, row in zip(WATER_STATE_KEYS, out)}
+        result['E'] = E
+        return result
+
     def _rho(self, T, p=0., x=0.):
         """
                 Density of water [kg/m3] versus temperature at 101.325 kPa
@@ -309,6 +458,34 @@ class Water(Liquid):
             rho /= 1. - (p - pRef) / max(E, 1e-20)
         return rho
 
+    def _rho_grad(self, T, p=0., x=0.):
+        """
+        Returns:
+            density and its gradient [drho/dT, drho/dp, drho/dx], 
+            see _rho()
+        """
+        T = K2C(T)
+        if self.rho.p.absolute:
+            pRef = 0.
+        else:
+            pRef = self.p.ref
+        a, b, c, d = 288.9414, 508929., 68.129630, 3.9863
+        f = (T + a) / (b * (T + c))
+        df_dT = (c - a) / (b * (T + c)**2)
+        g = (T - d)**2
+        dg_dT = 2. * (T - d)
+        rho = 1e3 * (1 - f * g)
+        drho_dT = -1e3 * (df_dT * g + f * dg_dT)
+        drho_dp = 0.
+        E = self.E.calc(T, p, x)
+        if E:
+            E = max(E, 1e-20)
+            s = 1. - (p - pRef) / E
+            rho /= s
+            drho_dT /= s
+            drho_dp = rho / (E * s)
+        return float(rho), np.array([drho_dT, drho_dp, 0.])
+
     def _nu(self, T, p=0., x=0.):
         """
          Kinematic viscosity of water [mm2/s] versus temperature at 101.325 kPa
@@ -344,6 +521,13 @@ class Water(Liquid):
         else:
             return 1996.
 
+    def _c_p_vec(self, T, p=0., x=0.):
+        T = np.asfarray(T)
+        c_p = 1e3 * (28.07 + T * (-0.2817 + T * (1.25e-3 +
+                     T * (-2.48e-6 + T * 1.857e-9))))
+        return np.where(T < self.T_liq, 2108., 
+                        np.where(T < self.T_boil, c_p, 1996.))
+
     def _mu(self, T, p=0., x=0.):
         A = 2.414e-5
         B = 247.8
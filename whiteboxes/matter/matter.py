@@ -22,7 +22,7 @@
 
 from collections import OrderedDict
 import numpy as np
-from typing import Callable, Dict, Optional
+from typing import Callable, Dict, Optional, Tuple
 
 from conversion import atm, C2K
 from property import Property
@@ -40,6 +40,15 @@ class Matter(Property):
         components_to_str() returns the chemical composition
     """
 
+    # properties whose 'calc' calls other properties of the matter, 
+    # see memoize_all()
+    MEMO_DEPENDS: Dict[str, Tuple[str, ...]] = {
+        'a': ('k', 'c_p', 'rho'),
+        'mu': ('rho',),
+        'nu': ('mu', 'rho'),
+        'rho': ('beta', 'E'),
+    }
+
     def __init__(self, identifier: str = __qualname__,
                  latex: str | None = None,
                  comment: str | None = None) -> None:
@@ -63,7 +72,7 @@ class Matter(Property):
         self.components: Dict[Matter, float] | None = None
 
         self.a = Property('a', 'm$^2$/s', comment='thermal diffusity',
-                          calc=self._a)
+                          calc=self._a, calc_vec=self._a_vec)
         self.beta = Property('beta', '1/K', latex=r'$\beta_{th}$',
                              comment='volumetric thermal expansion')
         self.c_p = Property('c_p', 'J/kg/K', comment='specific heat capacity')
@@ -91,82 +100,81 @@ class Matter(Property):
         self.T_melt: float = 0.
         self.T_sol: float = 0.
 
-        if self.E() is None or np.abs(self.E()) < 1e-20:
+        self._rho_with_E = not (self.E() is None or np.abs(self.E()) < 1e-20)
+        if not self._rho_with_E:
             self.rho.calc = lambda T, p, x: self.rho.ref \
                 / (1. + (T - self.rho.T.ref) * self.beta())
         else:
             self.rho.calc = lambda T, p, x: self.rho.ref \
                 / (1. + (T - self.rho.T.ref) * self.beta()) \
                 / (1. - (p - self.rho.p.ref) / self.E())
+        # the closed-form density model is also valid for arrays
+        self.rho.calc_vec = self.rho.calc
+        self.rho.calc_grad = self._rho_grad
 
+    def _rho_grad(self, T: float, p: float, 
+                  x: float) -> tuple[float, np.ndarray]:
+        """
+        Analytic gradient of default density model:
+        
+            rho = rho_ref / (1 + (T - T_ref) beta) / (1 - (p - p_ref) / E)
 
+        Returns:
+            density and gradient [drho/dT, drho/dp, drho/dx]
+        """
+        beta, E = self.beta(), self.E()
+        f_T = 1. + (T - self.rho.T.ref) * beta
+        rho = self.rho.ref / f_T
+        drho_dp = 0.
+        if self._rho_with_E:
+            f_p = 1. - (p - self.rho.p.ref) / E
+            rho /= f_p
+            drho_dp = rho / (E * f_p)
+        return rho, np.array([-rho * beta / f_T, drho_dp, 0.])
+
+    # Partial derivatives employ the analytic gradient 'calc_grad' or 
+    # dual numbers, see Property.grad(). The step sizes are only used
+    # by the finite difference fallback
 
     def dk_dT(self, T: float, p: float, x: float, 
               dT: float = 0.1) -> float | None:
-        try:
-            return (self.k(T+dT, p, x) - self.k(T, p, x)) / dT
-        except:
-            return None
+        return self.k.derivative(T, p, x, 'T', dT)
 
     def dk_dp(self, T: float, p: float, x: float, 
               dp: float = 1.) -> float | None:
-        try:
-            return (self.k(T, p+dp, x) - self.k(T, p, x)) / dp
-        except:
-            return None
+        return self.k.derivative(T, p, x, 'p', dp)
 
     def dk_dx(self, T: float, p: float, x: float, 
               dx: float = 0.001) -> float | None:
-        try:
-            return (self.k(T, p, x+dx) - self.k(T, p, x)) / dx
-        except:
-            return None
+        return self.k.derivative(T, p, x, 'x', dx)
 
 
     def drho_dT(self, T: float, p: float, x: float, 
                 dT: float = 0.1) -> float | None:
-        try:
-            return (self.rho(T+dT, p, x) - self.rho(T, p, x)) / dT
-        except:
-            return None
+        return self.rho.derivative(T, p, x, 'T', dT)
 
     def drho_dp(self, T: float, p: float, x: float, 
                 dp: float = 1.) -> float | None:
-        try:
-            return (self.rho(T, p+dp, x) - self.rho(T, p, x)) / dp
-        except:
-            return None
+        return self.rho.derivative(T, p, x, 'p', dp)
 
 
     def drho_dx(self, T: float, p: float, x: float, 
                 dx: float = 1e-4) -> float | None:
-        try:
-            return (self.rho(T, p, x+dx) - self.rho(T, p, x)) / dx
-        except:
-            return None
+        return self.rho.derivative(T, p, x, 'x', dx)
 
 
     def dcp_dT(self, T: float, p: float, x: float, 
                dT: float = 0.1) -> float | None:
-        try:
-            return (self.c_p(T+dT, p, x) - self.c_p(T, p, x)) / dT
-        except:
-            return None
+        return self.c_p.derivative(T, p, x, 'T', dT)
 
     def dcp_dp(self, T: float, p: float, x: float, 
                dp: float = 1.) -> float | None:
-        try:
-            return (self.c_p(T, p+dp, x) - self.c_p(T, p, x)) / dp
-        except:
-            return None
+        return self.c_p.derivative(T, p, x, 'p', dp)
 
 
     def dcp_dx(self, T: float, p: float, x: float, 
                dx: float = 0.001) -> float | None:
-        try:
-            return (self.c_p(T, p, x+dx) - self.c_p(T, p, x)) / dx
-        except:
-            return None
+        return self.c_p.derivative(T, p, x, 'x', dx)
 
 
     def _a(self, T: float, p: float = atm(), x: float = 0.) -> float | None:
@@ -183,6 +191,15 @@ class Matter(Property):
         except:
             return None
 
+    def _a_vec(self, T: np.ndarray, p: np.ndarray, 
+               x: np.ndarray) -> np.ndarray:
+        k, _ = self.k.eval_batch(T, p, x)
+        c_p, _ = self.c_p.eval_batch(T, p, x)
+        rho, _ = self.rho.eval_batch(T, p, x)
+        cp_rho = c_p * rho
+        with np.errstate(divide='ignore', invalid='ignore'):
+            return np.where(cp_rho < 1e-10, np.nan, k / cp_rho)
+
     def set_all_ref(self, T: float, p: float = atm(), x: float = 0.) -> bool:
         any_property_set = False
         for attr in dir(self):
@@ -196,6 +213,20 @@ class Matter(Property):
                     val.x.ref = x
         return not any_property_set
 
+    def memoize_all(self, maxsize: int | None = 1024, 
+                    tol: Tuple[float, float, float] = (0., 0., 0.)) -> None:
+        """
+        Enables or disables memoization of all properties of matter, 
+        see Property.memoize(). The properties called by derived 
+        properties (MEMO_DEPENDS) are part of their cache state
+        """
+        for key, val in self.__dict__.items():
+            if isinstance(val, Property):
+                depends = [getattr(self, dep) for dep in 
+                           self.MEMO_DEPENDS.get(key, ()) 
+                           if isinstance(getattr(self, dep, None), Property)]
+                val.memoize(maxsize, tol, depends)
+
     def plot(self, prop: Property | str | None = None) -> None:
         if prop is None or prop.lower() == 'all':
             for key, val in self.__dict__.items():
@@ -440,9 +471,11 @@ class Fluid(Matter):
         super().__init__(identifier=identifier, latex=latex, comment=comment)
 
         self.mu = Property('mu', 'Pa s', latex=r'$\mu$',
-                           comment='dynamic viscosity', calc=self._mu)
+                           comment='dynamic viscosity', calc=self._mu,
+                           calc_vec=self._mu_vec)
         self.nu = Property('nu', 'm^2/s', latex=r'$\nu$',
-                           comment='kinematic viscosity', calc=self._nu)
+                           comment='kinematic viscosity', calc=self._nu,
+                           calc_vec=self._nu_vec)
 
     def _mu(self, T: float, p: float = atm(), x: float = 0.) -> float | None:
         try:
@@ -459,6 +492,19 @@ class Fluid(Matter):
         except:
             return None
 
+    def _mu_vec(self, T: np.ndarray, p: np.ndarray, 
+                x: np.ndarray) -> np.ndarray:
+        nu, _ = self.nu.eval_batch(T, p, x)
+        rho, _ = self.rho.eval_batch(T, p, x)
+        return nu * rho
+
+    def _nu_vec(self, T: np.ndarray, p: np.ndarray, 
+                x: np.ndarray) -> np.ndarray:
+        mu, _ = self.mu.eval_batch(T, p, x)
+        rho, _ = self.rho.eval_batch(T, p, x)
+        with np.errstate(divide='ignore', invalid='ignore'):
+            return np.where(rho < 1e-10, np.nan, mu / rho)
+
 
 class Liquid(Fluid):
     """
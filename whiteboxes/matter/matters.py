@@ -20,18 +20,107 @@
       2020-12-13 DWW
 """
 
+import ast
 from collections import OrderedDict
-from typing import List, Optional, Union
+import importlib
+import importlib.util
+import inspect
+from typing import Dict, Iterable, List, Optional, Tuple, Union
 
-from coloredlids.matter import ferrous
-from coloredlids.matter import gases
-from coloredlids.matter import liquids
-from coloredlids.matter import nonferrous
-from coloredlids.matter import nonmetals
 from coloredlids.property.matter import Matter
 from grayboxes.base import Base
 
 
+# modules of matter in order of registration
+MATTER_MODULES = ('ferrous', 'nonferrous', 'nonmetals', 'liquids', 'gases')
+MATTER_PACKAGE = 'coloredlids.matter'
+
+
+def _default_identifier(func: Optional[ast.FunctionDef], 
+                        class_name: str) -> Optional[str]:
+    """
+    Returns:
+        default of argument 'identifier' of __init__() 
+        OR
+        None if not available as literal or __qualname__
+    """
+    if func is None:
+        return None
+    args = func.args.args
+    for arg, default in zip(args[len(args) - len(func.args.defaults):], 
+                            func.args.defaults):
+        if arg.arg == 'identifier':
+            if isinstance(default, ast.Constant) and \
+                    isinstance(default.value, str):
+                return default.value
+            if isinstance(default, ast.Name) and \
+                    default.id == '__qualname__':
+                return class_name
+    return None
+
+
+def index_module(module_name: str) -> List[Tuple[str, str]]:
+    """
+    Indexes public classes of matter module without importing it. The
+    source code is parsed and the identifier is taken from the default
+    of argument 'identifier' of __init__(), inherited from base classes
+    in the same module if needed
+    
+    Args:
+        module_name:
+            name of module in package MATTER_PACKAGE, e.g. 'gases'
+
+    Returns:
+        list of (class name, identifier) in order of definition
+    """
+    spec = importlib.util.find_spec(MATTER_PACKAGE + '.' + module_name)
+    if spec is None or spec.origin is None:
+        raise ImportError(module_name)
+    with open(spec.origin, encoding='utf-8') as file:
+        tree = ast.parse(file.read())
+
+    classes = {}
+    for node in tree.body:
+        if isinstance(node, ast.ClassDef):
+            init = next((f for f in node.body if isinstance(f, ast.FunctionDef)
+                         and f.name == '__init__'), None)
+            bases = [b.id for b in node.bases if isinstance(b, ast.Name)]
+            classes[node.name] = (init, bases)
+
+    def identifier_of(class_name: str) -> Optional[str]:
+        init, bases = classes[class_name]
+        if init is not None:
+            return _default_identifier(init, class_name)
+        for base in bases:
+            if base in classes:
+                return identifier_of(base)
+        return None
+
+    return [(name, identifier_of(name) or name) for name in classes
+            if name[0] != '_']
+
+
+def _index_imported_module(module_name: str) -> List[Tuple[str, str]]:
+    """
+    Fallback of index_module() if source is not available: imports 
+    module and reads defaults of 'identifier' without instantiation
+    """
+    mod = importlib.import_module(MATTER_PACKAGE + '.' + module_name)
+    index = []
+    for key, class_ in mod.__dict__.items():
+        if isinstance(class_, type) and key[0] != '_' and \
+                class_.__module__.lower() == mod.__name__.lower():
+            try:
+                identifier = inspect.signature(class_).parameters[
+                    'identifier'].default
+            except (KeyError, ValueError):
+                identifier = key
+            if not isinstance(identifier, str):
+                identifier = key
+            index.append((key, identifier))
+    return index
+
+
 class Matters(Base):
     """
     Convenience class providing properties of all matter in modules:
@@ -41,28 +130,71 @@ class Matters(Base):
         For getting a list of all available matter write:
             collection: matter = Matter() 
             all_matter: str = collection('all') 
+
+        The registry is lazy: class names and identifiers are indexed 
+        from the source code of the modules without importing them. 
+        A matter is created at its first selection and cached afterwards
     """
 
-    def __init__(self, identifier: str = 'Matters') -> None:
+    def __init__(self, identifier: str = 'Matters', 
+                 modules: Iterable[str] = MATTER_MODULES) -> None:
         """
         Args:
             identifier:
                 Identifier of collection of matter
+
+            modules:
+                names of modules of matter in package MATTER_PACKAGE
         """
         super().__init__(identifier=identifier)        
         self.program = self.__class__.__name__
 
-        classes = []
-        matter = (ferrous, nonferrous, nonmetals, liquids, gases,)
-        for mat in matter:
-            classes += [class_() for key, class_ in mat.__dict__.items()
-                        if isinstance(class_, type) and 
-                        key[0] != '_' and
-                        mat.__name__[0] != '_' and
-                        class_.__module__.lower() == mat.__name__.lower()]
-        self.data = OrderedDict()
-        for class_ in classes:
-            self.data[class_.identifier.lower()] = class_
+        # lower-case identifiers and class names -> (module, class name)
+        self._index: Dict[str, Tuple[str, str]] = OrderedDict()
+        self._class_names: Dict[str, Tuple[str, str]] = {}
+        self._cache: Dict[Tuple[str, str], Matter] = {}
+        for module_name in modules:
+            try:
+                index = index_module(module_name)
+            except (ImportError, OSError, SyntaxError):
+                index = _index_imported_module(module_name)
+            for class_name, mat_identifier in index:
+                key = (module_name, class_name)
+                self._index[mat_identifier.lower()] = key
+                self._class_names[class_name.lower()] = key
+
+    def _create(self, key: Tuple[str, str]) -> Optional[Matter]:
+        """
+        Returns:
+            cached or newly created instance of matter 
+            OR 
+            None if creation failed
+        """
+        if key not in self._cache:
+            module_name, class_name = key
+            try:
+                mod = importlib.import_module(MATTER_PACKAGE + '.' + 
+                                              module_name)
+                mat = getattr(mod, class_name)()
+            except Exception as e:
+                self.write(f'??? creation of matter: {class_name}, {e}')
+                return None
+            self._cache[key] = mat
+        return self._cache[key]
+
+    @property
+    def data(self) -> Dict[str, Matter]:
+        """
+        Returns:
+            dictionary of all matter: {lower-case identifier: matter}, 
+            creates all matter not created yet
+        """
+        data = OrderedDict()
+        for key in OrderedDict.fromkeys(self._index.values()):
+            mat = self._create(key)
+            if mat is not None:
+                data[mat.identifier.lower()] = mat
+        return data
 
     def __call__(self, identifier: Optional[str] = None) \
             -> Optional[Union[Matter, List[Matter]]]:
@@ -71,7 +203,7 @@ class Matters(Base):
 
         Args:
             identifier:
-                Identifier of matter.
+                Identifier or class name of matter.
                 If None or 'all', then all matter will be returned
 
         Returns:
@@ -88,14 +220,16 @@ class Matters(Base):
         """
         if identifier is None or identifier == 'all':
             return self.data.values()
-        if identifier.lower() not in self.data:
+        key = self._index.get(identifier.lower(), 
+                              self._class_names.get(identifier.lower()))
+        if key is None:
             self.write('??? unknown identifier of matter: ' + identifier)
             return None
-        return self.data[identifier.lower()]
+        return self._create(key)
 
     def __str__(self) -> str:
         """
         Returns:
             List of String of keys list of available matter
         """
-        return str(self.data.keys())    
+        return str(self._index.keys())    
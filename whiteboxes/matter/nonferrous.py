@@ -58,7 +58,7 @@ class Aluminum(NonFerrous):
 
         self.T.ref = C2K(20)
 
-        self.M.calc       = lambda T=0, p=0, x=0: 26.9815386e-3  # [kg/mol]
+        self.M.calc       = 26.9815386e-3  # [kg/mol]
 
         self.nu_mech      = None
         self.friction     = None
@@ -72,12 +72,12 @@ class Aluminum(NonFerrous):
         self.h_melt       = h_melt_mol / self.M()
         self.h_vap        = h_vap_mol / self.M()
 
-        self.beta.calc    = lambda T=0, p=0, x=0: 23.1e-6
+        self.beta.calc    = 23.1e-6
         self.c_p.calc     = lambda T=0, p=0, x=0: 24.2 / self.M()
-        self.k.calc       = lambda T=0, p=0, x=0: 237.
+        self.k.calc       = 237.
         self.rho.calc     = lambda T=0, p=0, x=0: 2700. if T < self.T_sol \
                                                            else 2375
-        self.rho_el.calc  = lambda T=0, p=0, x=0: 26.5e-9
+        self.rho_el.calc  = 26.5e-9
 
 
 class Copper(NonFerrous):
@@ -108,10 +108,10 @@ class Copper(NonFerrous):
 
         self.nu_mech      = None
         self.friction     = None
-        self.E.calc       = lambda T=0, p=0, x=0: 137.8e+9
+        self.E.calc       = 137.8e+9
 
         self.T_sol        = C2K(2560)
-        self.beta.calc    = lambda T=0, p=0, x=0: 16.3e-6
-        self.c_p.calc     = lambda T=0, p=0, x=0: 129
-        self.k.calc       = lambda T=0, p=0, x=0: 386
-        self.rho.calc     = lambda T=0, p=0, x=0: 8960
+        self.beta.calc    = 16.3e-6
+        self.c_p.calc     = 129
+        self.k.calc       = 386
+        self.rho.calc     = 8960
@@ -70,13 +70,13 @@ class R4_230NA(NonMetal):
         self.friction = 0.5
         self.R_compr.calc = lambda T=0, p=0, x=0: 0*K2C(T) + 268e6
 
-        self.E.calc       = lambda T=0, p=0, x=0: 14.5e+9
-        self.beta.calc    = lambda T=0, p=0, x=0: 15e-6
-        self.c_p.calc     = lambda T=0, p=0, x=0: 1000
+        self.E.calc       = 14.5e+9
+        self.beta.calc    = 15e-6
+        self.c_p.calc     = 1000
         # TODO difference between c_p of reference [2]:1003 and [3]:1000
-        self.k.calc       = lambda T=0, p=0, x=0: 3.63
-        self.rho.calc     = lambda T=0, p=0, x=0: 1680
-        self.rho_el.calc  = lambda T=0, p=0, x=0: 1e+12
+        self.k.calc       = 3.63
+        self.rho.calc     = 1680
+        self.rho_el.calc  = 1e+12
 
         self.T_melt = (C2K(1399), C2K(1454))
 
@@ -97,9 +97,9 @@ class Concrete(NonMetal):
                 comment on matter
         """
         super().__init__(identifier, latex=latex, comment=comment)
-        self.c_p.calc = lambda T=0, p=0, x=0: 0.8
-        self.rho.calc = lambda T=0, p=0, x=0: 2300
-        self.k.calc   = lambda T=0, p=0, x=0: 1.8
+        self.c_p.calc = 0.8
+        self.rho.calc = 2300
+        self.k.calc   = 1.8
 
 
 class Ceramic(NonMetal):
@@ -118,6 +118,6 @@ class Ceramic(NonMetal):
                 comment on matter
         """
         super().__init__(identifier, latex=latex, comment=comment)
-        self.c_p.calc = lambda T=0, p=0, x=0: 835
-        self.rho.calc = lambda T=0, p=0, x=0: 1920
-        self.k.calc   = lambda T=0, p=0, x=0: 0.72
+        self.c_p.calc = 835
+        self.rho.calc = 1920
+        self.k.calc   = 0.72
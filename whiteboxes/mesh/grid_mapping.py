@@ -20,14 +20,413 @@
       2021-07-01 DWW
 """
 
-__all__ = ['irregular_grid_mapping']
+__all__ = ['GridMapper', 'irregular_grid_mapping']
 
 
+from concurrent.futures import ThreadPoolExecutor
+import hashlib
 import numpy as np
+import os
 from scipy.interpolate import (CloughTocher2DInterpolator, 
                                LinearNDInterpolator, NearestNDInterpolator)
-from scipy.spatial import Delaunay
-from typing import Optional
+from scipy.sparse import csr_matrix
+from scipy.spatial import cKDTree, Delaunay
+from typing import Any, Callable, List, Optional, Tuple, Union
+
+
+def _stack(X: np.ndarray, Y: np.ndarray, 
+           Z: Optional[np.ndarray]) -> np.ndarray:
+    """
+    Returns:
+        coordinates as 2D array of shape (n_points, n_dim)
+    """
+    if Z is None:
+        return np.column_stack((np.ravel(X), np.ravel(Y))).astype(float)
+    return np.column_stack((np.ravel(X), np.ravel(Y), 
+                            np.ravel(Z))).astype(float)
+
+
+def _open(a: Union[str, np.ndarray]) -> np.ndarray:
+    """
+    Returns:
+        array; if 'a' is path to .npy-file, it is memory-mapped read-only
+    """
+    if isinstance(a, str):
+        return np.load(a, mmap_mode='r')
+    return a
+
+
+def _blocks(n: int, chunk_size: Optional[int]) -> List[slice]:
+    """
+    Returns:
+        slices of consecutive blocks of range(n)
+    """
+    if not chunk_size or chunk_size >= n:
+        return [slice(0, n)]
+    return [slice(i, min(i + chunk_size, n)) 
+            for i in range(0, n, chunk_size)]
+
+
+class GridMapper(object):
+    """
+    Maps any number of fields from an irregular source grid to an 
+    irregular target grid in 2D or 3D space:
+        U(X,Y,Z) -> u(x,y,z) if Z is not None  
+        U(X,Y)   -> u(x,y)   if Z is None 
+
+    The source points are triangulated once. For linear and nearest 
+    neighbor interpolation the target points are located once and their 
+    interpolation weights are stored as sparse matrix W of shape 
+    (n_target, n_source). Mapping of N fields is then a single sparse
+    product: u = W @ U with U of shape (n_source, N)
+
+    Example:
+        mapper = GridMapper(X, Y, Z, x, y, z, file='cfd_to_fem.npz')
+        T, p = mapper(np.column_stack((T_cfd, p_cfd))).T
+        u = mapper(U_cfd)
+
+        # large 3D grids stored as (n, 3) arrays in .npy-files
+        mapper = GridMapper.from_points('cfd_xyz.npy', 'fem_xyz.npy',
+                                        chunk_size=100000, n_jobs=8)
+        u = mapper(np.load('cfd_T.npy', mmap_mode='r'))
+        print(mapper.n_outside, 'points outside:', mapper.outside_indices)
+
+    Note:
+        - weights are persisted if 'file' is given; the file is reused 
+          if source grid, target grid and method are unchanged
+        - target points outside of the convex hull of the source points
+          are marked in 'outside' (linear and Clough-Tocher method)
+        - if 'chunk_size' is given, target points are processed in 
+          blocks of 'chunk_size' points on 'n_jobs' threads. Only the
+          active blocks of memory-mapped targets are resident in memory
+        - the triangulation (Qhull) is built on a single core
+    """
+
+    def __init__(self, 
+                 X: np.ndarray, Y: np.ndarray, Z: Optional[np.ndarray],
+                 x: np.ndarray, y: np.ndarray, z: Optional[np.ndarray],
+                 method: str = 'linear',
+                 file: Optional[str] = None,
+                 chunk_size: Optional[int] = None,
+                 n_jobs: int = 1) -> None:
+        """
+        Args:
+            X, Y, Z (1D arrays of float):
+                coordinates of source grid, Z is None in 2D space
+
+            x, y, z (1D arrays of float):
+                coordinates of target grid, z is None in 2D space
+
+            method:
+                identifier of interpolation method, starts with:
+                    'l': linear
+                    'n': nearest neighbor
+                    'c': CloughTocher algorithm, only if Z is None
+                argument is not case sensitive
+
+            file:
+                path to .npz-file of interpolation weights. If None, 
+                weights are not persisted
+
+            chunk_size:
+                number of target points per block. If None, all target
+                points are processed in one block
+
+            n_jobs:
+                number of threads processing blocks of target points
+        """
+        assert (Z is None) == (z is None)
+        self._setup(_stack(X, Y, Z), _stack(x, y, z), method, file, 
+                    chunk_size, n_jobs)
+
+    @classmethod
+    def from_points(cls, 
+                    points: Union[str, np.ndarray], 
+                    targets: Union[str, np.ndarray],
+                    method: str = 'linear',
+                    file: Optional[str] = None,
+                    chunk_size: Optional[int] = None,
+                    n_jobs: int = 1) -> 'GridMapper':
+        """
+        Creates mapper from coordinate arrays without copying them
+
+        Args:
+            points (2D array of float or str):
+                source coordinates, shape (n_source, n_dim)
+                OR
+                path to .npy-file of source coordinates, memory-mapped
+
+            targets (2D array of float or str):
+                target coordinates, shape (n_target, n_dim)
+                OR
+                path to .npy-file of target coordinates, memory-mapped
+
+            method, file, chunk_size, n_jobs:
+                see __init__()
+
+        Returns:
+            grid mapper
+        """
+        mapper = cls.__new__(cls)
+        mapper._setup(_open(points), _open(targets), method, file, 
+                      chunk_size, n_jobs)
+        return mapper
+
+    def _setup(self, points: np.ndarray, targets: np.ndarray, method: str,
+               file: Optional[str], chunk_size: Optional[int], 
+               n_jobs: int) -> None:
+        assert points.ndim == targets.ndim == 2
+        assert points.shape[1] == targets.shape[1] in (2, 3), \
+            str((points.shape, targets.shape))
+        self.points = points
+        self.targets = targets
+
+        method = method.lower()
+        if method.startswith('n'):
+            self.method = 'nearest'
+        elif method.startswith('c') and points.shape[1] == 2:
+            self.method = 'clough'
+        else:
+            self.method = 'linear'
+        self.file = file
+        self.chunk_size = chunk_size
+        self.n_jobs = max(1, int(n_jobs))
+
+        self.weights: Optional[csr_matrix] = None
+        self.outside: Optional[np.ndarray] = None
+        self._triangulation: Optional[Delaunay] = None
+
+        if self.method != 'clough':
+            if not self.load():
+                self.build()
+                self.save()
+        else:
+            self.triangulation.transform
+            self.outside = np.concatenate(self._map_blocks(
+                lambda t: self.triangulation.find_simplex(t) < 0))
+
+    @property
+    def n_source(self) -> int:
+        return self.points.shape[0]
+
+    @property
+    def n_target(self) -> int:
+        return self.targets.shape[0]
+
+    @property
+    def n_outside(self) -> int:
+        """
+        Returns:
+            number of target points outside of convex hull of source
+        """
+        return int(np.count_nonzero(self.outside))
+
+    @property
+    def outside_indices(self) -> np.ndarray:
+        """
+        Returns:
+            indices of target points outside of convex hull of source
+        """
+        return np.flatnonzero(self.outside)
+
+    @property
+    def triangulation(self) -> Delaunay:
+        """
+        Returns:
+            Delaunay triangulation of source points, built at first call
+        """
+        if self._triangulation is None:
+            self._triangulation = Delaunay(np.asarray(self.points, 
+                                                      dtype=float))
+        return self._triangulation
+
+    @property
+    def key(self) -> str:
+        """
+        Returns:
+            hash of method and of source and target coordinates
+        """
+        h = hashlib.md5(self.method.encode())
+        for a in (self.points, self.targets):
+            h.update(str(a.shape).encode())
+            for block in _blocks(a.shape[0], self.chunk_size or 1000000):
+                h.update(np.ascontiguousarray(a[block], 
+                                              dtype=float).tobytes())
+        return h.hexdigest()
+
+    def _map_blocks(self, func: Callable[[np.ndarray], Any]) -> List[Any]:
+        """
+        Applies function to blocks of target points, see 'chunk_size'
+
+        Args:
+            func:
+                function of target coordinates of one block, 
+                shape (n_block, n_dim)
+
+        Returns:
+            results of function in order of blocks
+        """
+        task = lambda block: func(np.asarray(self.targets[block], 
+                                             dtype=float))
+        blocks = _blocks(self.n_target, self.chunk_size)
+        if self.n_jobs == 1 or len(blocks) == 1:
+            return [task(block) for block in blocks]
+        with ThreadPoolExecutor(max_workers=self.n_jobs) as pool:
+            return list(pool.map(task, blocks))
+
+    def _locate(self, targets: np.ndarray) -> Tuple[np.ndarray, np.ndarray,
+                                                    np.ndarray]:
+        """
+        Locates block of target points in triangulation
+
+        Returns:
+            inside: True if target point is in convex hull of source
+            vertices: indices of source points of simplices, 
+                shape (n_inside, n_dim+1)
+            weights: barycentric weights, shape (n_inside, n_dim+1)
+        """
+        n_dim = targets.shape[1]
+        tri = self.triangulation
+        simplex = tri.find_simplex(targets)
+        inside = simplex >= 0
+        simplex = simplex[inside]
+
+        # barycentric coordinates from affine transform of simplices
+        trans = tri.transform[simplex]
+        bary = np.einsum('ijk,ik->ij', trans[:, :n_dim], 
+                         targets[inside] - trans[:, n_dim])
+        w = np.column_stack((bary, 1. - bary.sum(axis=1)))
+
+        return inside, tri.simplices[simplex], w
+
+    def build(self) -> 'GridMapper':
+        """
+        Locates target points and computes interpolation weights
+
+        Returns:
+            self
+        """
+        n_dim = self.points.shape[1]
+        if self.method == 'nearest':
+            tree = cKDTree(np.asarray(self.points, dtype=float))
+            vertices = np.concatenate(self._map_blocks(
+                lambda t: tree.query(t)[1]))
+            self.outside = np.zeros(self.n_target, dtype=bool)
+            self.weights = csr_matrix(
+                (np.ones(self.n_target), vertices, 
+                 np.arange(self.n_target + 1)), 
+                shape=(self.n_target, self.n_source))
+            return self
+
+        # transform is computed once before threads share triangulation
+        self.triangulation.transform
+        located = self._map_blocks(self._locate)
+        inside = np.concatenate([loc[0] for loc in located])
+        vertices = np.concatenate([loc[1].ravel() for loc in located])
+        w = np.concatenate([loc[2].ravel() for loc in located])
+        del located
+
+        indptr = np.zeros(self.n_target + 1, dtype=np.int64)
+        indptr[1:] = np.cumsum(np.where(inside, n_dim + 1, 0))
+        self.outside = ~inside
+        self.weights = csr_matrix((w, vertices, indptr),
+                                  shape=(self.n_target, self.n_source))
+        return self
+
+    def save(self) -> bool:
+        """
+        Writes weights atomically to file
+
+        Returns:
+            False if weights are not persisted or writing failed
+        """
+        if not self.file or self.weights is None:
+            return False
+        tmp = self.file + '.' + str(os.getpid()) + '.tmp.npz'
+        try:
+            np.savez(tmp, key=self.key, data=self.weights.data, 
+                     indices=self.weights.indices, 
+                     indptr=self.weights.indptr, outside=self.outside)
+            os.replace(tmp, self.file)
+        except OSError:
+            return False
+        return True
+
+    def load(self) -> bool:
+        """
+        Reads weights from file
+
+        Returns:
+            False if file does not exist, is not readable or belongs to 
+            other grids or method
+        """
+        if not self.file or not os.path.isfile(self.file):
+            return False
+        try:
+            with np.load(self.file) as data:
+                if str(data['key']) != self.key:
+                    return False
+                self.weights = csr_matrix(
+                    (data['data'], data['indices'], data['indptr']),
+                    shape=(self.n_target, self.n_source))
+                self.outside = data['outside']
+        except (OSError, KeyError, ValueError):
+            return False
+        return True
+
+    def __call__(self, U: Union[str, np.ndarray], 
+                 fill_value: float = 0.,
+                 out: Optional[np.ndarray] = None) -> np.ndarray:
+        """
+        Args:
+            U (1D or 2D array of float or str):
+                field values on source grid, shape (n_source,) or
+                (n_source, N) for N fields
+                OR
+                path to .npy-file of field values, memory-mapped
+
+            fill_value:
+                value of target points outside of convex hull of source 
+                points, see 'outside'
+
+            out (1D or 2D array of float):
+                optional array for result, e.g. memory-mapped .npy-file
+                created with np.lib.format.open_memmap()
+
+        Returns:
+            u (1D or 2D array of float):
+                field values on target grid, shape (n_target,) or
+                (n_target, N)
+        """
+        U = _open(U)
+        assert U.shape[0] == self.n_source, str((U.shape, self.n_source))
+        if out is None:
+            out = np.empty((self.n_target,) + U.shape[1:])
+        assert out.shape == (self.n_target,) + U.shape[1:], str(out.shape)
+
+        blocks = _blocks(self.n_target, self.chunk_size)
+        if self.method == 'clough':
+            # gradients are estimated globally, interpolator is not local
+            interpolator = CloughTocher2DInterpolator(self.triangulation, 
+                np.asarray(U, dtype=float), fill_value=fill_value)
+
+            def task(block: slice) -> None:
+                out[block] = interpolator(np.asarray(self.targets[block], 
+                                                     dtype=float))
+        else:
+            def task(block: slice) -> None:
+                out[block] = self.weights[block] @ U
+
+        if self.n_jobs == 1 or len(blocks) == 1:
+            for block in blocks:
+                task(block)
+        else:
+            with ThreadPoolExecutor(max_workers=self.n_jobs) as pool:
+                list(pool.map(task, blocks))
+
+        if self.outside.any():
+            out[self.outside] = fill_value
+        return out
 
 
 def irregular_grid_mapping(
@@ -35,7 +434,11 @@ def irregular_grid_mapping(
         U: np.ndarray, 
         x: np.ndarray, y: np.ndarray, z: Optional[np.ndarray],
         method: str = 'linear',
-        ) -> Optional[np.ndarray]:    
+        chunk_size: Optional[int] = None,
+        n_jobs: int = 1,
+        fill_value: float = 0.,
+        return_outside: bool = False,
+        ) -> Optional[Union[np.ndarray, Tuple[np.ndarray, np.ndarray]]]:
     """
     Maps data on irregular source grid to irregular target grid in 2D 
     or 3D space: 
@@ -71,14 +474,43 @@ def irregular_grid_mapping(
                 'c': CloughTocher algorithm, only if Z is None
             argument is not case sensitive
 
+        chunk_size:
+            number of target points per block. If None, all target
+            points are processed in one block
+
+        n_jobs:
+            number of threads processing blocks of target points
+
+        fill_value:
+            value of target points outside of convex hull of source 
+            points
+
+        return_outside:
+            if True, then mask of target points outside of convex hull of 
+            source points is returned in addition
+
     Returns:
         u (1D array of float):
             dependent variable u(x,y,z) or u(x,y) on target grid
             OR
+            (u, outside) if return_outside is True
+            OR
             None if mapping fails
-        
+
+    Note:
+        For mapping of several fields between the same grids, create a
+        GridMapper once and apply it to all fields. GridMapper raises
+        exceptions instead of returning None
     """
-    return irregular_grid_mapping_single_unknown(X, Y, Z, U, x, y, z, method)    
+    try:
+        mapper = GridMapper(X, Y, Z, x, y, z, method, chunk_size=chunk_size, 
+                            n_jobs=n_jobs)
+        u = mapper(U, fill_value=fill_value)
+    except:
+        return None
+    if return_outside:
+        return u, mapper.outside
+    return u
 
     
     
@@ -142,9 +574,9 @@ def irregular_grid_mapping_single_unknown(
     else:
         triang = Delaunay(np.array((X, Y, Z)).T)
         
-    if method.upper().startswith('n'):
+    if method.lower().startswith('n'):
         interpolator = NearestNDInterpolator(triang, U, fill_value=0.)
-    elif Z is None and method.upper().startswith('c'):
+    elif Z is None and method.lower().startswith('c'):
         interpolator = CloughTocher2DInterpolator(triang, U, fill_value=0.)
     else:
         interpolator = LinearNDInterpolator(triang, U, fill_value=0.)
@@ -22,6 +22,241 @@
 
 import numpy as np
 import matplotlib.pyplot as plt
+from typing import Iterator, List, Sequence, Tuple
+
+
+def _log_normalized(n, start=0, stop=1, base=10, reverse=False, 
+                    dtype=np.float32):
+    """
+    Normalized logarithmic spaced array (grid density decreases with
+    index if reverse is False)
+    """
+    x = (np.logspace(start, stop, n, base=base, dtype=dtype) -
+         base**start) / (base**stop - base**start)
+    if reverse:
+        x = x[::-1]
+    return x.astype(dtype, copy=False)
+
+
+def _axis(rng, n, spacing, dtype):
+    """
+    Vertex, center and step size arrays of one axis including ghost 
+    cells, all of type 'dtype', see partly_regular()
+
+    Returns:
+        (3-tuple of 1D arrays of float):
+            vertices X, centers x and step sizes dx, size: abs(n)+1
+    """
+    lo, up = dtype(min(rng[0], rng[1])), dtype(max(rng[0], rng[1]))
+    abs_n = abs(n)
+    L = lambda n, reverse=False: _log_normalized(n, reverse=reverse, 
+                                                 dtype=dtype)
+    spc = spacing.lower()
+    if spc == 'lin':
+        X = np.linspace(lo, up, abs_n, dtype=dtype)
+    elif spc == 'log-':
+        X = lo + (up-lo) * L(abs_n)
+    elif spc == 'log+':
+        X = up - (up-lo) * (L(abs_n, reverse=True))
+    elif spc in ('log+-', 'log-+'):
+        assert lo < 0 and up > 0, str((lo, up))
+
+        n_lo = max(1, round(abs_n * float(lo) / (-float(up) + float(lo))))
+        n_up = abs_n - n_lo
+        if spc == 'log-+':
+            X_lo = lo + (0-lo) * L(n_lo)
+            X_up = 0 + (up-0) * (1 - L(n_up, reverse=True)[1:])
+        else:
+            X_lo = lo + (0-lo) * (1-L(n_lo, reverse=True))
+            X_up = 0 + (up-0) * (L(n_up))
+        X = np.append(X_lo, X_up)
+    else:
+        assert 0, str(spacing)
+
+    X = np.append(X, X[-1]).astype(dtype, copy=False)
+    x = np.empty_like(X)
+    x[0] = X[0]
+    np.add(X[:-1], X[1:], out=x[1:])
+    x[1:] *= dtype(0.5)
+    dx = np.empty_like(X)
+    dx[0] = 0
+    np.subtract(X[1:], X[:-1], out=dx[1:])
+
+    return X, x, dx
+
+
+class PartlyRegularMesh(object):
+    """
+    Structured (lazy) variant of partly_regular(): only the 1D arrays per
+    axis are stored, memory is O(n0 + n1 + n2) instead of O(n0 n1 n2)
+
+    - X_views(), x_views() and dx_views() return per-axis arrays as 
+      broadcastable views, e.g. of shape (n0, 1, 1), (1, n1, 1), 
+      (1, 1, n2) in 3D
+    - cell volumes are products of the step sizes: iter_V() yields 
+      slabs of V along one axis, volume() returns single cells,
+      total_volume is the sum over all cells
+    - dense() materializes the tensor products of partly_regular()
+
+    Example:
+        mesh = PartlyRegularMesh((512, 512, 512), (0, 1), (0, 1), (0, 2))
+        dx0, dx1, dx2 = mesh.dx_views()
+        flux = k * (T[1:] - T[:-1]) / dx0[1:]     # broadcast to 3D
+        for i, V_slab in mesh.iter_V():           # 2D slabs (n1, n2)
+            Q[i] = (q[i] * V_slab).sum()
+    """
+
+    def __init__(self, n_cells, *ranges, spacing='lin', dtype=np.float32):
+        """
+        Args:
+            n_cells, ranges, spacing, dtype:
+                see partly_regular()
+        """
+        assert dtype in (np.float32, np.float64), str(dtype)
+        ranges, spacing = list(ranges), list(np.atleast_1d(spacing))
+        N = list(np.atleast_1d(n_cells))
+        n = N + [N[-1]] * (len(ranges) - len(N))  # fill n up to len(ranges)
+        assert len(n) == len(ranges), str((n, n_cells, ranges))
+        assert 1 <= len(ranges) <= 3, 'ranges.shape[0] <= 3 ' + \
+            str(np.shape(ranges))
+        spacing = spacing + [spacing[-1]] * (len(ranges) - len(spacing))
+
+        self.dtype = dtype
+        self.n_cells: List[int] = [int(_n) for _n in n]
+        self.X1d: List[np.ndarray] = []
+        self.x1d: List[np.ndarray] = []
+        self.dx1d: List[np.ndarray] = []
+        for rng, _n, _spc in zip(ranges, n, spacing):
+            X_j, x_j, dx_j = _axis(rng, _n, _spc, dtype)
+            self.X1d.append(X_j)
+            self.x1d.append(x_j)
+            self.dx1d.append(dx_j)
+
+    @property
+    def ndim(self) -> int:
+        return len(self.X1d)
+
+    @property
+    def shape(self) -> Tuple[int, ...]:
+        """
+        Returns:
+            number of vertices (and of cell centers) per axis
+        """
+        return tuple(X_j.size for X_j in self.X1d)
+
+    @property
+    def nbytes_dense(self) -> int:
+        """
+        Returns:
+            memory of dense arrays X, x, dx and V of dense() [byte]
+        """
+        return (3 * self.ndim + 1) * int(np.prod(self.shape)) * \
+            np.dtype(self.dtype).itemsize
+
+    @staticmethod
+    def _views(arrays: Sequence[np.ndarray]) -> List[np.ndarray]:
+        """
+        Returns:
+            1D arrays reshaped to broadcastable views, array j has 
+            size > 1 only in dimension j
+        """
+        views = []
+        for j, a in enumerate(arrays):
+            shape = [1] * len(arrays)
+            shape[j] = a.size
+            views.append(a.reshape(shape))
+        return views
+
+    def X_views(self) -> List[np.ndarray]:
+        """
+        Returns:
+            vertex coordinates per axis as broadcastable views
+        """
+        return self._views(self.X1d)
+
+    def x_views(self) -> List[np.ndarray]:
+        """
+        Returns:
+            center coordinates per axis as broadcastable views
+        """
+        return self._views(self.x1d)
+
+    def dx_views(self) -> List[np.ndarray]:
+        """
+        Returns:
+            step sizes per axis as broadcastable views
+        """
+        return self._views(self.dx1d)
+
+    def volume(self, *index: int) -> float:
+        """
+        Args:
+            index:
+                cell index per axis
+
+        Returns:
+            volume of single cell (length in 1D, area in 2D)
+        """
+        assert len(index) == self.ndim, str(index)
+        v = self.dtype(1)
+        for dx_j, i in zip(self.dx1d, index):
+            v *= dx_j[i]
+        return v
+
+    @property
+    def total_volume(self) -> float:
+        """
+        Returns:
+            sum of volumes of all cells
+        """
+        return float(np.prod([dx_j.sum(dtype=np.float64) 
+                              for dx_j in self.dx1d]))
+
+    def iter_V(self, axis: int = 0) -> Iterator[Tuple[int, np.ndarray]]:
+        """
+        Iterates over slabs of cell volumes, peak memory is one slab
+
+        Args:
+            axis:
+                axis of iteration
+
+        Yields:
+            index along axis and array of cell volumes of slab with 
+            (ndim - 1) dimensions; a float in 1D
+        """
+        others = [dx_j for j, dx_j in enumerate(self.dx1d) if j != axis]
+        slab = np.ones((), dtype=self.dtype)
+        for dx_j in self._views(others):
+            slab = slab * dx_j
+        for i, dx_i in enumerate(self.dx1d[axis]):
+            yield i, dx_i * slab
+
+    def dense(self, transpose: bool = False) \
+            -> Tuple[np.ndarray, np.ndarray, np.ndarray, np.ndarray]:
+        """
+        Materializes tensor products, see partly_regular()
+
+        Args:
+            transpose:
+                if True, then 1D arrays are transposed to column vectors
+
+        Returns:
+            (4-tuple of arrays of float with dimension: n+1):
+                vertex coordinates X, center coordinates x, step sizes dx
+                and cell volumes V
+        """
+        if self.ndim == 1:
+            X, x, dx = (np.atleast_2d(a[0]) for a in
+                        (self.X1d, self.x1d, self.dx1d))
+            if transpose:
+                X, x, dx = X.T, x.T, dx.T
+            return X, x, dx, dx
+
+        X = np.stack(np.meshgrid(*self.X1d, indexing='ij'))
+        x = np.stack(np.meshgrid(*self.x1d, indexing='ij'))
+        dx = np.stack(np.meshgrid(*self.dx1d, indexing='ij'))
+        V = np.prod(dx, axis=0, dtype=self.dtype)
+        return X, x, dx, V
 
 
 def partly_regular(n_cells, *ranges, spacing='lin', dtype=np.float32,
@@ -93,91 +328,16 @@ def partly_regular(n_cells, *ranges, spacing='lin', dtype=np.float32,
             - list center coordinates x
             - list of step sizes dx
             - list of cell volumes V
-    """
-    ranges, spacing = list(ranges), list(np.atleast_1d(spacing))
-    N = list(np.atleast_1d(n_cells))
-    n = N + [N[-1]] * (len(ranges) - len(N))  # fill n-array up to: len(ranges)
-    assert len(n) == len(ranges), str((n, n_cells, ranges))
-    ranges = np.asfarray(ranges)
-    spacing = spacing + [spacing[-1]] * (len(ranges) - len(spacing))
-
-    # vertex 'X' and center 'x' nodes as 1D arrays
-    X1d, x1d, dx1d = [], [], []
-    for rng, _n, _spc in zip(ranges, n, spacing):
-        rngLo = min(rng[0], rng[1])
-        rngUp = max(rng[0], rng[1])
-        abs_n = abs(_n)
-
-        def L(n, start=0, stop=1, base=10, reverse=False):
-            """
-            Normalized logarithmic spaced array (grid density decreases with
-            index if reverse is False)
-            """
-            x = (np.logspace(start, stop, n, base=base, dtype=dtype) -
-                 base**start) / (base**stop - base**start)
-            if reverse:
-                x = x[::-1]
-            return x
-
-        if _spc.lower() == 'lin':
-            X_j = np.linspace(rngLo, rngUp, abs(_n), dtype=dtype)
-        elif _spc.lower() == 'log-':
-            X_j = rngLo + (rngUp-rngLo) * L(abs_n)
-        elif _spc.lower() == 'log+':
-            X_j = rngUp - (rngUp-rngLo) * (L(abs_n, reverse=True))
-        elif _spc.lower() in ('log+-', 'log-+'):
-            assert rngLo < 0 and rngUp > 0, str((rngLo, rngUp))
-
-            nLo = max(1, round(abs_n * rngLo / (-rngUp + rngLo)))
-            nUp = abs_n - nLo
-            if _spc.lower() == 'log-+':
-                lo = rngLo + (0-rngLo) * L(nLo)
-                up = 0 + (rngUp-0) * (1 - L(nUp, reverse=True)[1:])
-            else:
-                lo = rngLo + (0-rngLo) * (1-L(nLo, reverse=True))
-                up = 0 + (rngUp-0) * (L(nUp))
-            X_j = np.append(lo, up)
-        else:
-            assert 0, str(_spc)
-
-        X_j = np.append(X_j, X_j[-1])
-        X1d.append(X_j)
-
-        x_j = np.append(X_j[0], 0.5 * (X_j[:-1] + X_j[1:]))
-        x1d.append(x_j)
-
-        dx_j = np.append(np.array([0], dtype=dtype), (X_j[1:] - X_j[:-1]))
-        dx1d.append(dx_j)
-
-    if ranges.shape[0] == 1:
-        X, x, dx = np.atleast_2d(X1d[0]), np.atleast_2d(x1d[0]), \
-            np.atleast_2d(dx1d[0])
-        if _n < 0:
-            X, x, dx = X.T, x.T, dx.T
-        V = dx
-
-    elif ranges.shape[0] == 2:
-        n0, n1 = x1d[0].size, x1d[1].size
-        X = np.asarray([np.asarray([X1d[0]] * n1).T, [X1d[1]] * n0])
-        x = np.asarray([np.asarray([x1d[0]] * n1).T, [x1d[1]] * n0])
-        dx = np.asarray([np.asarray([dx1d[0]] * n1).T, [dx1d[1]] * n0])
-        V = dx[0] * dx[1]
-
-    elif ranges.shape[0] == 3:
-        n0, n1, n2 = x1d[0].size, x1d[1].size, x1d[2].size
-        X = np.asarray([np.asarray([[X1d[0]] * n1] * n2).T,
-                       np.asarray([np.asarray([X1d[1]] * n0).T] * n2).T,
-                       [[X1d[2]] * n1] * n0])
-        x = np.asarray([np.asarray([[x1d[0]] * n1] * n2).T,
-                       np.asarray([np.asarray([x1d[1]] * n0).T] * n2).T,
-                       [[x1d[2]] * n1] * n0])
-        dx = np.asarray([np.asarray([[dx1d[0]] * n1] * n2).T,
-                        np.asarray([np.asarray([dx1d[1]] * n0).T] * n2).T,
-                        [[dx1d[2]] * n1] * n0])
-        V = np.asarray(dx[0] * dx[1] * dx[2])
 
-    else:
-        assert 0, 'ranges.shape[0] <= 3 ' + str(ranges.shape)
+    Note:
+        The tensor products are dense, use PartlyRegularMesh for large 
+        grids
+    """
+    mesh = PartlyRegularMesh(n_cells, *ranges, spacing=spacing, 
+                             dtype=dtype)
+    X1d, x1d = mesh.X1d, mesh.x1d
+    X, x, dx, V = mesh.dense(transpose=mesh.ndim == 1 and 
+                             mesh.n_cells[0] < 0)
 
     assert all([_.dtype == dtype for _ in [x, dx, X, V]]), \
         str([_.dtype for _ in [x, dx, X, V]])
@@ -0,0 +1,162 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+from numba import jit
+import numpy as np
+
+__all__ = ['tdma', 'tdma_batch', 'tdma_inplace', 'tdma_kernel']
+
+
+@jit(nopython=True, cache=True)
+def tdma_inplace(Lo: np.ndarray, Di: np.ndarray, Up: np.ndarray,
+                 Rs: np.ndarray, c: np.ndarray, x: np.ndarray) -> np.ndarray:
+    """
+    Compiled Thomas algorithm without allocation, see tdma()
+
+    Args:
+        Lo, Di, Up, Rs:
+            diagonals and right-hand side, not modified
+        c:
+            work array, size of Di
+            -- will be modified
+        x:
+            solution vector, size of Di, must not share memory with
+            the other arguments
+            -- will be modified
+
+    Returns:
+        x
+    """
+    n = Di.size
+
+    # forward elimination
+    c[0] = Up[0] / Di[0]
+    x[0] = Rs[0] / Di[0]
+    for i in range(1, n):
+        m = 1. / (Di[i] - Lo[i] * c[i-1])
+        c[i] = Up[i] * m
+        x[i] = (Rs[i] - Lo[i] * x[i-1]) * m
+
+    # back substitution
+    for i in range(n-2, -1, -1):
+        x[i] -= c[i] * x[i+1]
+    return x
+
+
+@jit(nopython=True, cache=True)
+def _tdma(Lo: np.ndarray, Di: np.ndarray, Up: np.ndarray,
+          Rs: np.ndarray) -> np.ndarray:
+    n = Di.size
+    return tdma_inplace(Lo, Di, Up, Rs, np.empty(n), np.empty(n))
+
+
+# compiled Thomas algorithm allocating its work and solution arrays, 
+# can be called from other @jit functions, see tdma_inplace()
+tdma_kernel = _tdma
+
+
+def tdma(Lo: np.ndarray, Di: np.ndarray, Up: np.ndarray,
+         Rs: np.ndarray) -> np.ndarray:
+    """
+    Solves tridiagonal linear equation system with the Thomas algorithm
+
+        | Di[0]  Up[0]                     |   | x[0]   |   | Rs[0]   |
+        | Lo[1]  Di[1]  Up[1]              |   | x[1]   |   | Rs[1]   |
+        |        ...    ...    ...         | * | ...    | = | ...     |
+        |               Lo[n-1]  Di[n-1]   |   | x[n-1] |   | Rs[n-1] |
+
+    Args:
+        Lo:
+            lower diagonal, Lo[0] is not used
+        Di:
+            main diagonal
+        Up:
+            upper diagonal, Up[n-1] is not used
+        Rs:
+            right-hand side
+
+    Returns:
+        solution vector x
+
+    Note:
+        Input arrays are not modified. The algorithm is stable for
+        diagonally dominant matrices without pivoting
+    """
+    return _tdma(np.asfarray(Lo), np.asfarray(Di), np.asfarray(Up),
+                 np.asfarray(Rs))
+
+
+@jit(nopython=True, cache=True)
+def _tdma_batch(Lo: np.ndarray, Di: np.ndarray, Up: np.ndarray,
+                Rs: np.ndarray) -> np.ndarray:
+    n, m = Di.shape
+    c = np.empty((n, m))
+    x = np.empty((n, m))
+
+    # forward elimination, inner loop sweeps across systems
+    for j in range(m):
+        c[0, j] = Up[0, j] / Di[0, j]
+        x[0, j] = Rs[0, j] / Di[0, j]
+    for i in range(1, n):
+        for j in range(m):
+            f = 1. / (Di[i, j] - Lo[i, j] * c[i-1, j])
+            c[i, j] = Up[i, j] * f
+            x[i, j] = (Rs[i, j] - Lo[i, j] * x[i-1, j]) * f
+
+    # back substitution
+    for i in range(n-2, -1, -1):
+        for j in range(m):
+            x[i, j] -= c[i, j] * x[i+1, j]
+    return x
+
+
+def tdma_batch(Lo: np.ndarray, Di: np.ndarray, Up: np.ndarray,
+               Rs: np.ndarray) -> np.ndarray:
+    """
+    Solves M independent tridiagonal systems of size N in one call,
+    see tdma()
+
+    Args:
+        Lo:
+            lower diagonals, 2D array of shape (N, M)
+        Di:
+            main diagonals, 2D array of shape (N, M)
+        Up:
+            upper diagonals, 2D array of shape (N, M)
+        Rs:
+            right-hand sides, 2D array of shape (N, M)
+
+    Returns:
+        solutions, 2D array of shape (N, M); column j is solution of
+        system j
+
+    Note:
+        Systems are interleaved on the fast (last) axis of the C-ordered
+        arrays: the elimination proceeds row by row and sweeps over all
+        M systems in the inner loop, which is compiled to SIMD code.
+        Non-contiguous input is copied
+    """
+    Lo, Di, Up, Rs = (np.ascontiguousarray(a, dtype=float)
+                      for a in (Lo, Di, Up, Rs))
+    assert Di.ndim == 2 and Lo.shape == Di.shape == Up.shape == Rs.shape, \
+        str((Lo.shape, Di.shape, Up.shape, Rs.shape))
+    return _tdma_batch(Lo, Di, Up, Rs)
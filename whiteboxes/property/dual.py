@@ -0,0 +1,191 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+__all__ = ['Dual', 'seed']
+
+import numpy as np
+from typing import Iterable, Tuple, Union
+
+
+class Dual(object):
+    """
+    Dual number for forward-mode automatic differentiation
+
+        u = val + sum_i { der[i] * eps_i },   eps_i * eps_j = 0
+
+    Closed-form property functions composed of arithmetic operators and
+    of NumPy functions (np.exp, np.log, np.sqrt, ...) return the value
+    and the gradient with respect to all seeded variables in a single
+    evaluation, see seed() and Property.grad()
+
+    Note:
+        - comparisons act on the value, branches in property functions
+          select the active branch
+        - conversion to float is not supported: functions converting
+          their arguments (e.g. np.asfarray, CoolProp) raise TypeError,
+          then the caller falls back to finite differences
+    """
+
+    __slots__ = ('val', 'der')
+
+    def __init__(self, val: float, der: Union[float, Iterable[float]]) \
+            -> None:
+        self.val = val
+        self.der = np.asfarray(der)
+
+    def __repr__(self) -> str:
+        return f'Dual({self.val}, {self.der})'
+
+    @staticmethod
+    def _split(other: Union['Dual', float]) -> Tuple[float, Union[float,
+                                                     np.ndarray]]:
+        if isinstance(other, Dual):
+            return other.val, other.der
+        return other, 0.
+
+    # arithmetic operators
+
+    def __add__(self, other: Union['Dual', float]) -> 'Dual':
+        val, der = Dual._split(other)
+        return Dual(self.val + val, self.der + der)
+
+    __radd__ = __add__
+
+    def __sub__(self, other: Union['Dual', float]) -> 'Dual':
+        val, der = Dual._split(other)
+        return Dual(self.val - val, self.der - der)
+
+    def __rsub__(self, other: float) -> 'Dual':
+        return Dual(other - self.val, -self.der)
+
+    def __mul__(self, other: Union['Dual', float]) -> 'Dual':
+        val, der = Dual._split(other)
+        return Dual(self.val * val, self.der * val + self.val * der)
+
+    __rmul__ = __mul__
+
+    def __truediv__(self, other: Union['Dual', float]) -> 'Dual':
+        val, der = Dual._split(other)
+        return Dual(self.val / val, (self.der * val - self.val * der)
+                    / (val * val))
+
+    def __rtruediv__(self, other: float) -> 'Dual':
+        return Dual(other / self.val, -other * self.der
+                    / (self.val * self.val))
+
+    def __pow__(self, other: Union['Dual', float]) -> 'Dual':
+        if isinstance(other, Dual):
+            val = self.val ** other.val
+            return Dual(val, val * (other.der * np.log(self.val) +
+                                    other.val * self.der / self.val))
+        return Dual(self.val ** other,
+                    other * self.val ** (other - 1) * self.der)
+
+    def __rpow__(self, other: float) -> 'Dual':
+        val = other ** self.val
+        return Dual(val, val * np.log(other) * self.der)
+
+    def __neg__(self) -> 'Dual':
+        return Dual(-self.val, -self.der)
+
+    def __pos__(self) -> 'Dual':
+        return self
+
+    def __abs__(self) -> 'Dual':
+        return self if self.val >= 0. else -self
+
+    # comparisons act on value
+
+    def __lt__(self, other: Union['Dual', float]) -> bool:
+        return self.val < Dual._split(other)[0]
+
+    def __le__(self, other: Union['Dual', float]) -> bool:
+        return self.val <= Dual._split(other)[0]
+
+    def __gt__(self, other: Union['Dual', float]) -> bool:
+        return self.val > Dual._split(other)[0]
+
+    def __ge__(self, other: Union['Dual', float]) -> bool:
+        return self.val >= Dual._split(other)[0]
+
+    def __eq__(self, other: object) -> bool:
+        return self.val == Dual._split(other)[0]
+
+    def __ne__(self, other: object) -> bool:
+        return self.val != Dual._split(other)[0]
+
+    def __hash__(self) -> int:
+        return hash(self.val)
+
+    def __bool__(self) -> bool:
+        return bool(self.val)
+
+    # methods called by NumPy ufuncs on objects, e.g. np.exp(u)
+
+    def exp(self) -> 'Dual':
+        val = np.exp(self.val)
+        return Dual(val, val * self.der)
+
+    def log(self) -> 'Dual':
+        return Dual(np.log(self.val), self.der / self.val)
+
+    def log10(self) -> 'Dual':
+        return Dual(np.log10(self.val), self.der / (self.val * np.log(10.)))
+
+    def sqrt(self) -> 'Dual':
+        val = np.sqrt(self.val)
+        return Dual(val, 0.5 * self.der / val)
+
+    def square(self) -> 'Dual':
+        return self * self
+
+    def sin(self) -> 'Dual':
+        return Dual(np.sin(self.val), np.cos(self.val) * self.der)
+
+    def cos(self) -> 'Dual':
+        return Dual(np.cos(self.val), -np.sin(self.val) * self.der)
+
+    def tanh(self) -> 'Dual':
+        val = np.tanh(self.val)
+        return Dual(val, (1. - val * val) * self.der)
+
+    def arctan(self) -> 'Dual':
+        return Dual(np.arctan(self.val), self.der / (1. + self.val**2))
+
+
+def seed(*values: float) -> Tuple[Dual, ...]:
+    """
+    Creates independent dual variables
+
+    Args:
+        values:
+            values of independent variables, e.g. T, p and x
+
+    Returns:
+        dual numbers with unit gradient in their own direction
+
+    Example:
+        T, p, x = seed(300., 1e5, 0.)
+        y = f(T, p, x)          # y.val: f(300, 1e5, 0), y.der: gradient
+    """
+    n = len(values)
+    return tuple(Dual(val, np.eye(n)[i]) for i, val in enumerate(values))
@@ -22,16 +22,20 @@
 
 from collections import OrderedDict
 import numpy as np
-from typing import Dict, Optional
+from typing import Dict, List, Optional, Tuple
+
+R_U = 8.314462618  # universal gas constant [J/mol/K]
 
 try:
     from conversion import atm
     from matter import Gas
-    from mixformulas import mix_mason, mix_mass, mix_mole
+    from mixformulas import mason_coefficients, mix_mason, mix_mass, \
+        mix_mole
 except:
     from coloredlids.property.conversion import atm
     from coloredlids.property.matter import Gas
-    from coloredlids.property.mixformulas import mix_mason, mix_mass, mix_mole
+    from coloredlids.property.mixformulas import mason_coefficients, \
+        mix_mason, mix_mass, mix_mole
 
 
 class GasMix(Gas):
@@ -106,11 +110,18 @@ class GasMix(Gas):
         mass fraction is:
             m = N * M -> N = m/M -> N_i/N = (m_i/M_i) / (m_tot/M_tot)
             M_tot = sum_i {y_i * M_i} [kmol/kmol] * [kmol]
+
+        The composition dependent parts of the mixing rules (mole 
+        fractions, molar masses, mass fractions and the Mason & Saxena 
+        coefficient matrices) are computed once in add(). The kernels
+        assigned to 'calc_vec' evaluate all components at arrays of T 
+        and p in one pass, see Property.eval_batch()
     """
 
     def __init__(self, identifier: str = 'gas_mix',
                  latex: Optional[str] = None,
-                 comment: Optional[str] = None) -> None:
+                 comment: Optional[str] = None,
+                 k_mix_formula: Optional[str] = None) -> None:
         """
         Args:
             identifier:
@@ -122,6 +133,10 @@ class GasMix(Gas):
             comment:
                 Comment on matter
 
+            k_mix_formula:
+                mixing rule of thermal conductivity: 'mason' or 'mole'. 
+                If None, 'mason' is used
+
         Note:
             Do NOT define a self.__call__() method in this class
         """
@@ -133,10 +148,22 @@ class GasMix(Gas):
         self.k.calc = self._k
         self.mu.calc = self._mu
         self.rho.calc = self._rho
+
+        self.c_p.calc_vec = self._c_p_vec
+        self.k.calc_vec = self._k_vec
+        self.mu.calc_vec = self._mu_vec
+        self.rho.calc_vec = self._rho_vec
+        
+        # ['mason', 'mole']
+        self._k_mix_formula: str = k_mix_formula or 'mason'
         
-        self._k_mix_formula: str = 'mason'   # ['mason', 'mole']
+        # composition dependent data, updated in add()
+        self._gases: List[Gas] = []
+        self._y = np.zeros(0)
+        self._M = np.zeros(0)
+        self._mason: Optional[Tuple[np.ndarray, np.ndarray, np.ndarray]] = None
         
-    def add(self, component: Gas, mole_frac: float) -> bool:
+    def add(self, component: Gas, mole_frac: Optional[float] = None) -> bool:
         """
         Args:
             component:
@@ -144,6 +171,8 @@ class GasMix(Gas):
                 
             mole_frac:
                 mole fraction of component [mol/mol]
+                OR
+                None -> filling up so that sum of mole fractions is 1.0
 
         Returns:
             False if component is False
@@ -153,15 +182,32 @@ class GasMix(Gas):
         
         if not isinstance(component, Gas):
             component = component()
+        if mole_frac is None:
+            mole_frac = 1. - np.sum(list(self.components.values()))
         self.components[component] = mole_frac
 
         M = 0.
         for gas, mole_frac in self.components.items():
             M += mole_frac * gas.M()
         self.M.calc = lambda T, p, x: M
+        self.M.calc_vec = lambda T, p, x: np.full(np.shape(T), M)
+        
+        self._update_composition()
 
         return True
 
+    def _update_composition(self) -> None:
+        """
+        Caches the composition dependent parts of the mixing rules. 
+        Components with mole fraction below 1e-8 are skipped
+        """
+        self._gases = [gas for gas, mole_frac in self.components.items()
+                       if mole_frac >= 1e-8]
+        self._y = np.array([self.components[gas] for gas in self._gases], 
+                           dtype=float)
+        self._M = np.array([gas.M() for gas in self._gases], dtype=float)
+        self._mason = mason_coefficients(self._y, self._M)
+
     def check(self, silent: bool = False) -> bool:
         if len(self.components.items()) == 0:
             return False
@@ -175,65 +221,161 @@ class GasMix(Gas):
                   self.components.values())
         return ok
 
-    def _c_p(self, T: float, p: float = atm(), x: float = 0.) -> float:
-        y_all, M_all, c_p_all = [], [], []
+    def memoize_all(self, maxsize: Optional[int] = 1024, 
+                    tol: Tuple[float, float, float] = (0., 0., 0.)) -> None:
+        """
+        Enables or disables memoization of the properties of all 
+        components, see Property.memoize(). The mixing rules are not 
+        memoized, they depend on the component properties and on the
+        composition
+        """
+        super().memoize_all(None)
+        for gas in self.components:
+            gas.memoize_all(maxsize, tol)
 
-        for gas, mole_frac in self.components.items():
-            if mole_frac < 1e-8:
-                continue
-            p_partial = mole_frac * p
-            
-            y_all.append(mole_frac) 
-            M_all.append(gas.M(T, p, x)) 
-            c_p_all.append(gas.c_p(T, p_partial))
-            
-        return mix_mass(y=y_all, M=M_all, property_=c_p_all)
+    def _components(self, key: str, T: float, p: float, 
+                    x: float) -> List[Optional[float]]:
+        """
+        Returns:
+            property 'key' of all components at their partial pressures
+        """
+        return [getattr(gas, key)(T, y_i * p, x) 
+                for gas, y_i in zip(self._gases, self._y)]
 
-    def _k(self, T: float, p: float = atm(), x: float = 0.) -> float:
-        y_all, M_all, k_all, mu_all = [], [], [], []
+    def _components_vec(self, key: str, T: np.ndarray, p: np.ndarray,
+                        x: np.ndarray) -> np.ndarray:
+        """
+        Returns:
+            property 'key' of all components at their partial pressures, 
+            2D array of shape (n_comp, T.size), invalid values are NaN
+        """
+        T, p, x = np.broadcast_arrays(np.asfarray(T), np.asfarray(p), 
+                                      np.asfarray(x))
+        values = np.empty((len(self._gases), T.size))
+        for i, (gas, y_i) in enumerate(zip(self._gases, self._y)):
+            values[i] = getattr(gas, key).eval_batch(T, y_i * p, x)[0] \
+                .ravel()
+        return values
+
+    def state(self, T: float, p: float = atm(), 
+              x: float = 0.) -> Dict[str, Optional[float]]:
+        """
+        Evaluates all properties of mixture with one state evaluation 
+        per component instead of one per component and property
+        
+        Args:
+            T:
+                temperature [K]
+            p:
+                pressure [Pa]
+            x:
+                spare parameter [/]
 
-        for gas, mole_frac in self.components.items():
-            if mole_frac < 1e-8:
-                continue
-            p_partial = mole_frac * p
+        Returns:
+            dictionary with keys 'rho', 'c_p', 'k', 'mu', 'M' and 
+            'c_sound'. Values are None if any component is invalid 
+
+        Note:
+            Components with a state() method (e.g. CoolProp based gases)
+            are evaluated at their partial pressures in a single call. 
+            For other components the properties are called separately.
+
+            The speed of sound of the mixture is estimated with the 
+            ideal gas relation c^2 = kappa R T / M, where the heat 
+            capacity ratio kappa = c_p / c_v is mixed by mass fractions
+            and the component c_v_i is derived from c_sound_i
+        """
+        keys = ('rho', 'c_p', 'k', 'mu', 'M', 'c_sound')
+        states = []
+        for gas, y_i in zip(self._gases, self._y):
+            if hasattr(gas, 'state'):
+                state = gas.state(T, y_i * p, x)
+            else:
+                state = {key: getattr(gas, key)(T, y_i * p, x) 
+                         for key in keys}
+            if any(state[key] is None for key in keys):
+                return {key: None for key in keys}
+            states.append(state)
+        if not states:
+            return {key: None for key in keys}
             
-            y_all.append(mole_frac) 
-            M_all.append(gas.M(T, p, x)) 
-            k_all.append(gas.k(T, p_partial, x)) 
-            mu_all.append(gas.mu(T, p_partial, x))
+        values = {key: np.array([state[key] for state in states]) 
+                  for key in keys}
+        M = float(np.dot(self._y, self._M))
+        Y = self._y * self._M / M
 
         if self._k_mix_formula.startswith('mas'):
-            k = mix_mason(y=y_all, M=M_all, k=k_all, mu=mu_all)
+            k = mix_mason(y=self._y, M=self._M, k=values['k'], 
+                          mu=values['mu'], coefficients=self._mason)
         else:
-            k = mix_mole(y=y_all, M=M_all, property_=k_all)
-            
-        return k
+            k = mix_mole(y=self._y, M=self._M, property_=values['k'])
+
+        kappa_i = values['c_sound']**2 * values['M'] / (R_U * T)
+        c_p = float(np.dot(Y, values['c_p']))
+        c_v = float(np.dot(Y, values['c_p'] / kappa_i))
+        c_sound = np.sqrt(c_p / c_v * R_U * T / M)
+
+        return {'rho': mix_mole(y=self._y, M=self._M, 
+                                property_=values['rho']),
+                'c_p': c_p, 
+                'k': k,
+                'mu': mix_mole(y=self._y, M=self._M, property_=values['mu']),
+                'M': M, 
+                'c_sound': float(c_sound)}
+
+    def _c_p(self, T: float, p: float = atm(), x: float = 0.) -> float:
+        c_p_all = self._components('c_p', T, p, x)
+        if None in c_p_all:
+            return None
+        return mix_mass(y=self._y, M=self._M, property_=c_p_all)
+
+    def _c_p_vec(self, T: np.ndarray, p: np.ndarray, 
+                 x: np.ndarray) -> np.ndarray:
+        c_p_all = self._components_vec('c_p', T, p, x)
+        return mix_mass(y=self._y, M=self._M, property_=c_p_all) \
+            .reshape(np.shape(T))
+
+    def _k(self, T: float, p: float = atm(), x: float = 0.) -> float:
+        k_all = self._components('k', T, p, x)
+        if self._k_mix_formula.startswith('mas'):
+            mu_all = self._components('mu', T, p, x)
+            return mix_mason(y=self._y, M=self._M, k=k_all, mu=mu_all,
+                             coefficients=self._mason)
+        if None in k_all:
+            return None
+        return mix_mole(y=self._y, M=self._M, property_=k_all)
+
+    def _k_vec(self, T: np.ndarray, p: np.ndarray, 
+               x: np.ndarray) -> np.ndarray:
+        k_all = self._components_vec('k', T, p, x)
+        if self._k_mix_formula.startswith('mas'):
+            mu_all = self._components_vec('mu', T, p, x)
+            k = mix_mason(y=self._y, M=self._M, k=k_all, mu=mu_all,
+                          coefficients=self._mason)
+        else:
+            k = mix_mole(y=self._y, M=self._M, property_=k_all)
+        return k.reshape(np.shape(T))
 
     def _mu(self, T: float, p: float = atm(), x: float = 0.) -> float:
-        y_all, M_all, mu_all = [], [], []
+        mu_all = self._components('mu', T, p, x)
+        if None in mu_all:
+            return None
+        return mix_mole(y=self._y, M=self._M, property_=mu_all)
 
-        for gas, mole_frac in self.components.items():
-            if mole_frac < 1e-8:
-                continue
-            p_partial = mole_frac * p
-            
-            y_all.append(mole_frac)
-            M_all.append(gas.M(T, p, x)) 
-            mu_all.append(gas.mu(T, p_partial, x))
-            
-        return mix_mole(y=y_all, M=M_all, property_=mu_all)
+    def _mu_vec(self, T: np.ndarray, p: np.ndarray, 
+                x: np.ndarray) -> np.ndarray:
+        mu_all = self._components_vec('mu', T, p, x)
+        return mix_mole(y=self._y, M=self._M, property_=mu_all) \
+            .reshape(np.shape(T))
 
     def _rho(self, T: float, p: float = atm(), x: float = 0.) -> float:
-        rho = 0.
-        for gas, mole_frac in self.components.items():
-            if mole_frac < 1e-8:
-                continue
-            p_partial = mole_frac * p
-            
-            rho_i = gas.rho(T, p_partial, x)
-            if rho_i is None:
-                return None
-            
-            rho += mole_frac * rho_i 
-            
-        return rho
+        rho_all = self._components('rho', T, p, x)
+        if None in rho_all:
+            return None
+        return mix_mole(y=self._y, M=self._M, property_=rho_all)
+
+    def _rho_vec(self, T: np.ndarray, p: np.ndarray, 
+                 x: np.ndarray) -> np.ndarray:
+        rho_all = self._components_vec('rho', T, p, x)
+        return mix_mole(y=self._y, M=self._M, property_=rho_all) \
+            .reshape(np.shape(T))
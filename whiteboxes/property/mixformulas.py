@@ -20,11 +20,20 @@
       2018-07-14 DWW
 """
 
-__all__ = ['mix_mole', 'mix_mass', 'mix_mason']
+__all__ = ['mix_mole', 'mix_mass', 'mix_mason', 'mason_coefficients']
 
 
 import numpy as np
-from typing import Iterable, Optional
+from typing import Iterable, Optional, Tuple, Union
+
+try:
+    from numba import jit
+except ImportError:
+    def jit(*args, **kwargs):
+        # numba is optional: without it, kernels are plain Python
+        if len(args) == 1 and callable(args[0]) and not kwargs:
+            return args[0]
+        return lambda func: func
 
 
 """
@@ -82,9 +91,20 @@ from typing import Iterable, Optional
 """
 
 
+def _sum_over_components(weights: np.ndarray, 
+                         properties: np.ndarray) -> Union[float, np.ndarray]:
+    """
+    Weighted sum over first axis of 'properties', shape (n_comp,) or 
+    (n_comp, n_points). Returns float in the first and array of shape 
+    (n_points,) in the second case
+    """
+    result = np.tensordot(weights, properties, axes=1)
+    return float(result) if np.ndim(result) == 0 else result
+
+
 def mix_mole(y: Iterable[float],
              M: Iterable[float],
-             property_: Iterable[float]) -> float:
+             property_: Iterable[float]) -> Union[float, np.ndarray]:
     """
     Calculates property of a mixture based on mole fractions of 
     mixture components. 
@@ -100,10 +120,13 @@ def mix_mole(y: Iterable[float],
             molar masses of components [kmol/kg]
 
         property_:
-            physical or chemical property of mixture components
+            physical or chemical property of mixture components, 
+            1D array of shape (n_comp,) or 2D array of shape 
+            (n_comp, n_points) if evaluated at n_points states
     
     Returns:
-        property of mixture [unit of 'property_']
+        property of mixture [unit of 'property_'], float or 1D array of
+        shape (n_points,)
         
     Note:
         mole fraction N_i/N of ideal gas component equals its volumetric 
@@ -119,13 +142,13 @@ def mix_mole(y: Iterable[float],
 
     mole_fractions = np.asfarray(y)
     properties = np.asfarray(property_) 
-    return np.sum(mole_fractions * properties)
+    return _sum_over_components(mole_fractions, properties)
 
 
 def mix_mass(y: Iterable[float],
              M: Iterable[float],
              property_: Iterable[float],
-             silent: bool = False) -> float:
+             silent: bool = False) -> Union[float, np.ndarray]:
     """
     Calculates mass fractions Y_i from mole fractions y_i and estimates 
     property of a mixture based on mixture components. 
@@ -142,13 +165,16 @@ def mix_mass(y: Iterable[float],
             molar masses of components [kmol/kg]
 
         property_:
-            physical or chemical property of mixture components
+            physical or chemical property of mixture components, 
+            1D array of shape (n_comp,) or 2D array of shape 
+            (n_comp, n_points) if evaluated at n_points states
 
         silent:
             if False, then print information
     
     Returns:
-        property of mixture in [unit('property_')]
+        property of mixture in [unit('property_')], float or 1D array of
+        shape (n_points,)
         
     Note:
         mole fraction y_i = N_i/N of an ideal gas component in an ideal 
@@ -167,18 +193,93 @@ def mix_mass(y: Iterable[float],
     
     M_total = np.sum(M * mole_fractions)
     mass_fractions = mole_fractions * M / M_total
-    return np.sum(properties * mass_fractions)
+    return _sum_over_components(mass_fractions, properties)
+
+
+def mason_coefficients(y: Iterable[float], M: Iterable[float]) \
+        -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    Computes the composition dependent parts of the Mason & Saxena 
+    equation, see mix_mason(). The interaction coefficient of the 
+    components i and j is:
+
+        Phi_ij = A_ij * (1 + sqrt(mu_i/mu_j) * B_ij)^2
+        
+        A_ij = c0 / sqrt(8 (1 + M_i/M_j)),   B_ij = (M_j/M_i)^(1/4)
+
+    The matrices A, B and the mole fraction ratios Y_ij = y_j/y_i do not 
+    depend on temperature and pressure. They are computed once per 
+    composition and passed to mix_mason()
+    
+    Args:
+        y:
+            mole fractions of components [kmol/kmol]
+            
+        M:
+            molar masses of components [kmol/kg]
+
+    Returns:
+        A, B, Y: 2D arrays of shape (n_comp, n_comp)
+        
+    Note: 
+        Invalid ratios (division by zero) are corrected as in the 
+        former scalar implementation: M_i/M_j = 1 and y_j/y_i = 1e20
+    """
+    y, M = np.asfarray(y), np.asfarray(M)
+    assert y.shape == M.shape and y.ndim == 1, f'{y=}, {M=}'
+    
+    c0 = 1.065  # TODO check correction for polyatomic gases: 1.065
+
+    with np.errstate(divide='ignore', invalid='ignore'):
+        M12 = M[:, np.newaxis] / M[np.newaxis, :]
+        M12 = np.where(np.isfinite(M12) & (M12 > 0.), M12, 1.)
+        y_ratio = y[np.newaxis, :] / y[:, np.newaxis]
+        y_ratio = np.where(np.isfinite(y_ratio), y_ratio, 1e20)
+    
+    A = c0 / (2. * np.sqrt(2)) / np.sqrt(1. + M12)
+    B = M12**-0.25
+    np.fill_diagonal(y_ratio, 0.)
+
+    return A, B, y_ratio
+
+
+@jit(nopython=True, cache=True)
+def _mix_mason(k: np.ndarray, mu: np.ndarray, A: np.ndarray, 
+               B: np.ndarray, y_ratio: np.ndarray, 
+               with_mu: bool) -> np.ndarray:
+    n, n_points = k.shape
+    k_mix = np.zeros(n_points)
+    for t in range(n_points):
+        for i in range(n):
+            denom = 1.
+            for j in range(n):
+                if i != j:
+                    if with_mu:
+                        mu12 = mu[i, t] / mu[j, t]
+                        if not np.isfinite(mu12) or mu12 < 0.:
+                            mu12 = 1.
+                        a = A[i, j] * (1. + np.sqrt(mu12) * B[i, j])**2
+                    else:
+                        a = 1.
+                    denom += a * y_ratio[i, j]
+            k_mix[t] += k[i, t] / denom
+    return k_mix
 
 
 def mix_mason(y: Iterable[float],
               M: Iterable[float], 
               k: Iterable[float], 
               mu: Optional[Iterable[float]],
-              silent: bool = False) -> float:
+              silent: bool = False,
+              coefficients: Optional[Tuple[np.ndarray, np.ndarray, 
+                                           np.ndarray]] = None) \
+        -> Optional[Union[float, np.ndarray]]:
     """
     Calculates thermal conductivity of gas mixture with equation by 
     Mason & Saxena
     
+        k = sum_i { k_i / (1 + sum_{j!=i} { Phi_ij * y_j/y_i }) }
+    
     Args:
         y:
             mole fractions of components [kmol/kmol]
@@ -187,15 +288,27 @@ def mix_mason(y: Iterable[float],
             molar masses of components [kmol/kg]
             
         k:
-            thermal conductivity of components [W/m/K]
+            thermal conductivity of components [W/m/K], 1D array of 
+            shape (n_comp,) or 2D array of shape (n_comp, n_points)
             
         mu:
-            dynamic viscosity of components [Pa s]
+            dynamic viscosity of components [Pa s], same shape as 'k'
             OR 
             None if ratio of viscosities is unknown
+
+        silent:
+            if False, then print information
+
+        coefficients:
+            result of mason_coefficients(y, M) 
+            OR
+            None, then coefficients are computed 
     
     Returns:
-        thermal conductivity of mixture [W/m/K]
+        thermal conductivity of mixture [W/m/K], float or 1D array of
+        shape (n_points,)
+        OR
+        None if any component conductivity is None
 
     Note:
         y_i = p_i/p_tot = V_i/V_tot, i=1..n_components
@@ -203,46 +316,27 @@ def mix_mason(y: Iterable[float],
     assert len(y) == len(M) == len(k), f'{y=}, {M=}, {k=}'
     assert mu is None or len(y) == len(mu), f'{y=}, {mu=}'
     
-    if None in list(k):
+    if any(k_i is None for k_i in k):
         return None
-        
-    c0 = 1.065  # TODO check correction for polyatomic gases: 1.065
     
-    def G(M1: float, M2: float, mu1: float, mu2: float) -> float:
-        try:
-            M12 = M1 / M2
-        except:
-            if not silent:
-                print('??? M1 M2', M1, M2, ' ==> correct to: M1/M2 = 1')
-            M12 = 1.
-        try:
-            mu12 = mu1 / mu2
-        except:
-            if not silent:
-                print('??? {mu1=}, {mu2=}, correct to: mu1/mu2 = 1')
-            mu12 = 1.
-
-        return c0 / (2. * np.sqrt(2)) / np.sqrt(1. + M12) \
-            * (1. + np.sqrt(mu12 / M12) * M12**0.25)**2
-            
-    k_mix = 0.
-    for i in range(len(y)):
-        denom = 1.
-        for j in range(len(y)):
-            if i != j: 
-                if mu is not None:
-                    a = G(M[i], M[j], mu[i], mu[j])
-                else:
-                    a = 1.
-                    if not silent:
-                        print('!!! mu is None')
-
-                try:
-                    b = y[j] / y[i]
-                except:
-                    b = 1e20
-                    if not silent:
-                        print('!!! y/y is 0.')
-                denom += a * b
-        k_mix += k[i] / denom
-    return k_mix
+    if coefficients is None:
+        coefficients = mason_coefficients(y, M)
+    A, B, y_ratio = coefficients
+    
+    k = np.asfarray(k)
+    scalar = k.ndim == 1
+    k = np.ascontiguousarray(k.reshape(len(y), -1))
+    if mu is None:
+        if not silent:
+            print('!!! mu is None')
+        mu = np.ones_like(k)
+        with_mu = False
+    else:
+        mu = np.array([np.nan if mu_i is None else mu_i for mu_i in mu] 
+                      if scalar else mu, dtype=float)
+        mu = np.ascontiguousarray(np.broadcast_to(mu.reshape(len(y), -1), 
+                                                  k.shape))
+        with_mu = True
+    
+    k_mix = _mix_mason(k, mu, A, B, y_ratio, with_mu)
+    return float(k_mix[0]) if scalar else k_mix
@@ -0,0 +1,417 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+__all__ = ['PropertyPack', 'Surrogate']
+
+import json
+import numpy as np
+import os
+import struct
+from scipy.interpolate import RectBivariateSpline
+from typing import Any, Dict, Iterable, List, Optional, Tuple, Union
+
+# file layout: MAGIC, length of JSON header as uint64, JSON header,
+# padding, float64 data block; arrays start at multiples of _ALIGN bytes
+MAGIC = b'WBPACK01'
+_ALIGN = 64
+
+
+class Surrogate(object):
+    """
+    Fast approximation of a property stored in a PropertyPack
+
+        kind 'poly':  y = c0 + c1*T + c2*T^2 + ...   for T in T_range
+        kind 'table': interpolation of y(T, p) on grid of PropertyTable
+
+    - the arrays are views of the pack, they are not copied if the pack
+      is memory mapped
+    - the relative error bound of the fit or table is 'max_rel_error'
+    - outside of T_range (and p_range of tables) the result is invalid
+
+    Note:
+        Polynomials are functions of T only, they have been fitted at
+        fixed p and x, see Property.regression_fit(). Bilinear tables
+        (degree 1) are evaluated directly; for bicubic tables the
+        spline is fitted at the first call
+    """
+
+    def __init__(self, name: str, meta: Dict[str, Any],
+                 arrays: Dict[str, np.ndarray]) -> None:
+        self.name = name
+        self.kind: str = meta['kind']
+        self.meta = meta
+        self.arrays = arrays
+        self.T_range: Tuple[float, float] = tuple(meta['T_range'])
+        self.p_range: Optional[Tuple[float, float]] = \
+            None if meta.get('p_range') is None else tuple(meta['p_range'])
+        self.max_rel_error: float = meta.get('max_rel_error', np.inf)
+        self._spline: Optional[RectBivariateSpline] = None
+
+    def __str__(self) -> str:
+        return '{} ({}): max rel error: {:.2e}'.format(self.name, self.kind,
+                                                      self.max_rel_error)
+
+    def _inside(self, T: np.ndarray, p: np.ndarray) -> np.ndarray:
+        inside = (T >= self.T_range[0]) & (T <= self.T_range[1])
+        if self.p_range is not None:
+            inside &= (p >= self.p_range[0]) & (p <= self.p_range[1])
+        return inside
+
+    def _bilinear(self, T: np.ndarray, p: np.ndarray) -> np.ndarray:
+        T_grid, p_grid = self.arrays['T_grid'], self.arrays['p_grid']
+        V = self.arrays['values']
+        i = np.clip(np.searchsorted(T_grid, T) - 1, 0, T_grid.size - 2)
+        j = np.clip(np.searchsorted(p_grid, p) - 1, 0, p_grid.size - 2)
+        u = (T - T_grid[i]) / (T_grid[i+1] - T_grid[i])
+        v = (p - p_grid[j]) / (p_grid[j+1] - p_grid[j])
+        return (1. - u) * ((1. - v) * V[i, j] + v * V[i, j+1]) + \
+            u * ((1. - v) * V[i+1, j] + v * V[i+1, j+1])
+
+    def evaluate(self, T: Union[float, Iterable[float]],
+                 p: Union[float, Iterable[float]] = 0.,
+                 x: Union[float, Iterable[float]] = 0.) -> np.ndarray:
+        """
+        Args:
+            T:
+                temperature [K]
+            p:
+                pressure [Pa], not used by polynomials
+            x:
+                dummy parameter [/]
+
+        Returns:
+            approximated values, array of broadcast shape of T and p.
+            Points outside of range are NaN
+        """
+        T, p = np.broadcast_arrays(np.asfarray(T), np.asfarray(p))
+        inside = self._inside(T, p)
+        y = np.full(T.shape, np.nan)
+        if not inside.any():
+            return y
+        Ti, pi = T[inside], p[inside]
+        if self.kind == 'poly':
+            yi = np.zeros(Ti.shape)
+            for c in self.arrays['coefficients'][::-1]:       # Horner
+                yi = yi * Ti + c
+        elif self.meta['degree'] == 1:
+            yi = self._bilinear(Ti, pi)
+        else:
+            if self._spline is None:
+                k = self.meta['degree']
+                self._spline = RectBivariateSpline(self.arrays['T_grid'],
+                    self.arrays['p_grid'], self.arrays['values'], kx=k,
+                    ky=k, s=0)
+            yi = self._spline.ev(Ti, pi)
+        y[inside] = yi
+        return y
+
+    def __call__(self, T: Union[float, Iterable[float]],
+                 p: Union[float, Iterable[float]] = 0.,
+                 x: Union[float, Iterable[float]] = 0.) \
+            -> Optional[Union[float, np.ndarray]]:
+        """
+        Same as evaluate(), but returns float for scalar arguments and
+        None if value is invalid (convention of Property.calc)
+        """
+        y = self.evaluate(T, p, x)
+        if y.ndim == 0:
+            return None if np.isnan(y) else float(y)
+        return y
+
+
+class PropertyPack(object):
+    """
+    Compiled collection of property surrogates (polynomial fits and
+    interpolation tables) in a single binary file. The file is memory
+    mapped read-only at loading, processes loading the same file share
+    its pages instead of rebuilding matters, CoolProp states, tables
+    and regression coefficients
+
+    - entries are named '<matter identifier>.<property key>'
+    - each entry carries its range of validity and relative error
+    - the file is written atomically, concurrent readers see either the
+      old or the new pack
+
+    Example:
+        # once
+        pack = PropertyPack()
+        pack.add_matter(Water(), keys=('rho', 'c_p', 'k'), order=3)
+        pack.add_table('CO2.rho', CO2().tabulate(keys=['rho'])['rho'])
+        pack.save('props.pack')
+
+        # in each worker: near-instant, no copy of data
+        pack = PropertyPack.load('props.pack')
+        water = Water()
+        pack.apply(water)               # replaces calc and calc_vec
+        rho = pack['Water.rho'](T=300.)
+    """
+
+    def __init__(self) -> None:
+        self._meta: Dict[str, Dict[str, Any]] = {}
+        self._arrays: Dict[str, Dict[str, np.ndarray]] = {}
+        self._surrogates: Dict[str, Surrogate] = {}
+        self.file: Optional[str] = None
+
+    def __str__(self) -> str:
+        return '\n'.join(str(self[name]) for name in self.names())
+
+    def __len__(self) -> int:
+        return len(self._meta)
+
+    def __contains__(self, name: str) -> bool:
+        return name in self._meta
+
+    def __getitem__(self, name: str) -> Surrogate:
+        if name not in self._surrogates:
+            self._surrogates[name] = Surrogate(name, self._meta[name],
+                                               self._arrays[name])
+        return self._surrogates[name]
+
+    def names(self) -> List[str]:
+        return list(self._meta)
+
+    def _add(self, name: str, meta: Dict[str, Any],
+             arrays: Dict[str, np.ndarray]) -> Surrogate:
+        self._meta[name] = meta
+        self._arrays[name] = {key: np.ascontiguousarray(val, dtype='<f8')
+                              for key, val in arrays.items()}
+        self._surrogates.pop(name, None)
+        return self[name]
+
+    def add_fit(self, name: str, prop: Any,
+                T_range: Optional[Tuple[float, float]] = None,
+                p: Optional[float] = None,
+                x: Optional[float] = None,
+                order: Union[int, str] = 3) -> Optional[Surrogate]:
+        """
+        Adds polynomial fit of property in T at fixed p and x, see
+        Property.regression_fit()
+
+        Args:
+            name:
+                name of entry
+            prop:
+                property of type Property
+            T_range:
+                temperature range. If None, operational range of prop.T
+            p, x:
+                pressure and spare parameter of fit. If None, prop.p.ref
+                and prop.x.ref are used
+            order:
+                order of polynomial
+
+        Returns:
+            surrogate
+            OR
+            None if property is invalid in T_range
+        """
+        if T_range is None:
+            T_range = (prop.T['operational'].lo, prop.T['operational'].up)
+        if p is None:
+            p = prop.p.ref
+        if x is None:
+            x = prop.x.ref if prop.x is not None and prop.x.ref is not None \
+                else 0.
+        coefficients = prop.regression_fit(T_range, (p, p + 1.),
+                                           (x, x + 1.), order)
+        if coefficients is None:
+            return None
+        meta = {'kind': 'poly', 'T_range': list(prop.regression_range),
+                'p': float(p), 'x': float(x), 'order': len(coefficients) - 1,
+                'max_rel_error': prop.regression_max_rel_error}
+        return self._add(name, meta, {'coefficients': coefficients})
+
+    def add_table(self, name: str, table: Any) -> Optional[Surrogate]:
+        """
+        Adds interpolation table of property in T and p
+
+        Args:
+            name:
+                name of entry
+            table:
+                table of type PropertyTable, it is built if necessary
+
+        Returns:
+            surrogate
+            OR
+            None if table could not be built
+        """
+        if not table._ensure():
+            return None
+        meta = {'kind': 'table', 'T_range': list(table.T_range),
+                'p_range': list(table.p_range), 'degree': table.degree,
+                'max_rel_error': table.max_rel_error}
+        return self._add(name, meta, {'T_grid': table.T_grid,
+                                      'p_grid': table.p_grid,
+                                      'values': table.values})
+
+    def add_matter(self, matter: Any, keys: Iterable[str],
+                   T_range: Optional[Tuple[float, float]] = None,
+                   order: Union[int, str] = 3) -> List[str]:
+        """
+        Adds polynomial fits of properties of matter, entries are named
+        '<matter.identifier>.<key>'. A property with an existing table
+        (Gas.tabulate()) is added as table
+
+        Args:
+            matter:
+                matter of type Matter
+            keys:
+                identifiers of properties, e.g. ('rho', 'c_p', 'k')
+            T_range:
+                temperature range. If None, operational range of property
+            order:
+                order of polynomials
+
+        Returns:
+            names of added entries
+        """
+        tables = getattr(matter, '_tables', {})
+        names = []
+        for key in keys:
+            name = matter.identifier + '.' + key
+            if key in tables:
+                added = self.add_table(name, tables[key])
+            else:
+                added = self.add_fit(name, getattr(matter, key), T_range,
+                                     order=order)
+            if added is not None:
+                names.append(name)
+        return names
+
+    def apply(self, matter: Any) -> List[str]:
+        """
+        Replaces 'calc' and 'calc_vec' of properties of matter by the
+        surrogates of entries named '<matter.identifier>.<key>'
+
+        Returns:
+            keys of replaced properties
+        """
+        keys = []
+        for name in self.names():
+            identifier, _, key = name.rpartition('.')
+            if identifier == matter.identifier and hasattr(matter, key):
+                prop = getattr(matter, key)
+                prop.calc = self[name]
+                prop.calc_vec = self[name].evaluate
+                keys.append(key)
+        return keys
+
+    def save(self, file: str) -> bool:
+        """
+        Writes pack atomically to file
+
+        Returns:
+            False if writing failed
+        """
+        entries, offset = {}, 0
+        for name, meta in self._meta.items():
+            layout = {}
+            for key, val in self._arrays[name].items():
+                layout[key] = [offset, list(val.shape)]
+                offset += -(-val.size * 8 // _ALIGN) * _ALIGN // 8
+            entries[name] = dict(meta, arrays=layout)
+        header = json.dumps({'version': 1, 'entries': entries}).encode()
+        start = -(-(len(MAGIC) + 8 + len(header)) // _ALIGN) * _ALIGN
+
+        tmp = file + '.' + str(os.getpid()) + '.tmp'
+        try:
+            with open(tmp, 'wb') as f:
+                f.write(MAGIC + struct.pack('<Q', len(header)) + header)
+                f.write(b'\0' * (start - f.tell()))
+                for name in self._meta:
+                    for key, val in self._arrays[name].items():
+                        f.seek(start + entries[name]['arrays'][key][0] * 8)
+                        f.write(val.tobytes())
+                f.truncate(start + offset * 8)
+            os.replace(tmp, file)
+        except OSError:
+            return False
+        self.file = file
+        return True
+
+    @classmethod
+    def load(cls, file: str, mmap: bool = True) -> 'PropertyPack':
+        """
+        Reads pack from file
+
+        Args:
+            file:
+                path to pack file
+            mmap:
+                if True, then the data block is memory mapped read-only,
+                otherwise it is read into memory
+
+        Returns:
+            pack
+
+        Raises:
+            OSError if file is not readable
+            ValueError if file is not a pack
+        """
+        with open(file, 'rb') as f:
+            if f.read(len(MAGIC)) != MAGIC:
+                raise ValueError(file + ': not a property pack')
+            size = struct.unpack('<Q', f.read(8))[0]
+            header = json.loads(f.read(size).decode())
+        start = -(-(len(MAGIC) + 8 + size) // _ALIGN) * _ALIGN
+        n = (os.path.getsize(file) - start) // 8
+
+        if n == 0:
+            data = np.empty(0)
+        elif mmap:
+            data = np.memmap(file, dtype='<f8', mode='r', offset=start,
+                             shape=(n,))
+        else:
+            data = np.fromfile(file, dtype='<f8', offset=start)
+
+        pack = cls()
+        for name, meta in header['entries'].items():
+            layout = meta.pop('arrays')
+            pack._meta[name] = meta
+            pack._arrays[name] = {
+                key: data[off:off + int(np.prod(shape))].reshape(shape)
+                for key, (off, shape) in layout.items()}
+        pack.file = file
+        return pack
+
+
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    ALL = 1
+
+    if 0 or ALL:
+        from tempfile import gettempdir
+        from whiteboxes.property.property import Property
+
+        foo = Property('k', 'W/m/K', calc=lambda T, p, x=0.:
+                       1. + 1e-2 * T + 1e-5 * T**2 + 1e-9 * np.exp(T / 50))
+        pack = PropertyPack()
+        pack.add_fit('Foo.k', foo, (300., 600.), order=4)
+        file = os.path.join(gettempdir(), 'example.pack')
+        pack.save(file)
+
+        pack = PropertyPack.load(file)
+        print(pack)
+        print(pack['Foo.k'](450.), foo(450.))
@@ -28,10 +28,10 @@ import matplotlib.pyplot as plt
 from typing import Dict, Optional, Iterable, Tuple, Union
 
 try:
-    from range import (Range, 
+    from range import (Range, make_rng, random_in_range,
         percentage_of_bound, is_bound_absolute, is_bound_relative_to_reading) 
 except:
-    from coloredlids.property.range import (Range, 
+    from coloredlids.property.range import (Range, make_rng, random_in_range,
         percentage_of_bound, is_bound_absolute, is_bound_relative_to_reading) 
 
 
@@ -427,15 +427,49 @@ class Parameter(object):
     def repeatability(self, value: Range) -> None:
         self._ranges['repeatability'] = value
 
+    def _bound_array(self, bound: float | str, ref: np.ndarray, 
+                     full_scale_bound: float | None) -> float | np.ndarray:
+        """
+        Converts bound to absolute value(s). The bound specification is
+        parsed once, bounds relative to reading are evaluated with all 
+        elements of 'ref' in one array operation
+
+        Args:
+            bound:
+                absolute bound, or bound relative to reading ('2%') or 
+                relative to full scale ('2%FS') 
+
+            ref:
+                array of reference values
+
+            full_scale_bound:
+                bound of full scale range corresponding to 'bound'
+
+        Returns:
+            absolute bound as float or as array of shape of 'ref'
+        """
+        if is_bound_absolute(bound):
+            return float(bound)
+        perc = percentage_of_bound(bound)
+        if is_bound_relative_to_reading(bound):
+            return perc * ref
+        return np.abs(perc) * full_scale_bound
+
     def simulate(self, range_key: str | None = None,
                  size: int | Tuple[int] | None = None,
-                 plot: bool = False) -> float | Iterable[float] | Range | None:
+                 plot: bool = False, 
+                 seed: int | None = None,
+                 stream: int = 0,
+                 rng: np.random.Generator | None = None) \
+            -> float | Iterable[float] | Range | None:
         """
         Simulates values within absolute and relative
         (to full_scale/reading) ranges
 
         Bounds relative to reading are calculated as percentages
-        of the elements of an already assigned self.ref array
+        of the elements of an already assigned self.ref array. All 
+        samples are generated in a single draw with per-element 
+        lower and upper bounds
 
         Args:
             range_key:
@@ -444,25 +478,44 @@ class Parameter(object):
             plot:
                 plot simulated array(s) if True
 
+            seed:
+                key of reproducible counter-based random generator, 
+                see range.make_rng(). If None and rng is None, the 
+                global NumPy random state is used
+
+            stream:
+                index of random stream, e.g. worker index, for 
+                splitting simulations with the same seed
+
+            rng:
+                random generator, overrules 'seed' and 'stream'
+
         Returns:
             False if range_key is invalid or self.ref is empty in case
             that a bound is relative to reading, eg. (-1, '10%', None)
+
+        Example:
+            # worker k of n simulates its own slice reproducibly
+            par.ref = ref_all[k::n]
+            par.simulate('accuracy', seed=42, stream=k)
         """
         if range_key is None:
             range_key = 'operational'
         if range_key not in self.ranges:
             return False
         if size is None and self.ref is not None:
-            size = self.ref.size
+            size = np.size(self.ref)
+        if rng is None and seed is not None:
+            rng = make_rng(seed, stream)
 
-        rng = self.ranges[range_key]
+        rng_ = self.ranges[range_key]
 
-        if (not is_bound_relative_to_reading(rng.lo) and
-            not is_bound_relative_to_reading(rng.up)):
+        if (not is_bound_relative_to_reading(rng_.lo) and
+            not is_bound_relative_to_reading(rng_.up)):
 
             # None of the bounds is relative to reading
-            self.val = rng.simulate(size=size,
-                                    full_scale=self.full_scale, plot=plot)
+            self.val = rng_.simulate(size=size, full_scale=self.full_scale, 
+                                     plot=plot, rng=rng)
             # add random data to reference array if reference exists
             if self.ref is not None:
                 self.val = self.ref + self.val
@@ -470,35 +523,19 @@ class Parameter(object):
             # One or both of the bounds is relative to reading
             if self.ref is None:
                 return None
-            val = []
-            for ref_ in np.atleast_1d(self.ref):
-                if is_bound_absolute(rng.lo):
-                    lo = float(rng.lo)
-                else:
-                    perc = percentage_of_bound(rng.lo)
-                    if is_bound_relative_to_reading(rng.lo):
-                        lo = perc * ref_
-                    else:
-                        lo = np.abs(perc) * self.full_scale.lo
-
-                if is_bound_absolute(rng.up):
-                    up = float(rng.up)
-                else:
-                    perc = percentage_of_bound(rng.up)
-                    if is_bound_relative_to_reading(rng.up):
-                        up = perc * ref_
-                    else:
-                        up = np.abs(perc) * self.full_scale.up
-                val_ = Range(lo, up, rng.distr).simulate()
-                val.append(val_)
+            ref = np.atleast_1d(np.asfarray(self.ref))
+            lo = self._bound_array(rng_.lo, ref, self.full_scale.lo)
+            up = self._bound_array(rng_.up, ref, self.full_scale.up)
+            val = random_in_range(lo, up, rng_.distr, size=ref.shape, 
+                                  rng=rng)
 
             # add random data to reference array
-            self.val = self.ref + np.asfarray(val)
+            self.val = self.ref + val
 
             if plot:
                 plt.plot(self.val, label='val', linestyle='', marker='.')
-                if is_bound_relative_to_reading(rng.lo) or \
-                   is_bound_relative_to_reading(rng.up):
+                if is_bound_relative_to_reading(rng_.lo) or \
+                   is_bound_relative_to_reading(rng_.up):
                     plt.plot(self.ref, label='ref', linestyle='', marker='.')
                     plt.legend()
                 plt.grid()
@@ -20,18 +20,122 @@
       2019-11-28 DWW
 """
 
+from collections import OrderedDict
 import matplotlib.pyplot as plt
 import numpy as np
-from typing import Callable, Iterable, List, Optional, Tuple, Union
+import threading
+from typing import (Any, Callable, Dict, Hashable, Iterable, List, Optional, 
+                    Tuple, Union)
 
 try:
     from conversion import atm, C2K
+    from dual import Dual, seed
     from parameter import Parameter
-    from range import Range
+    from range import make_rng, Range
 except:
     from coloredlids.property.conversion import atm, C2K
+    from coloredlids.property.dual import Dual, seed
     from coloredlids.property.parameter import Parameter
-    from coloredlids.property.range import Range
+    from coloredlids.property.range import make_rng, Range
+from whiteboxes.tools import telemetry
+
+
+def _to_float(value: Optional[Union[float, Iterable[float]]]) -> float:
+    """
+    Converts scalar result of Property.calc() to float 
+
+    Returns:
+        value as float
+        OR
+        NaN if value is None or cannot be converted
+    """
+    if value is None:
+        return np.nan
+    try:
+        return float(np.ravel(value)[0])
+    except (IndexError, TypeError, ValueError):
+        return np.nan
+
+
+class _Memo(object):
+    """
+    Bounded, thread-safe LRU cache of scalar property values keyed on 
+    quantized (T, p, x), see Property.memoize()
+    """
+
+    def __init__(self, maxsize: int, tol: Tuple[float, float, float]) \
+            -> None:
+        self.maxsize = maxsize
+        self.tol = tuple(float(t) for t in tol)
+        self.hits = 0
+        self.misses = 0
+        self.refs: Optional[Tuple[Any, ...]] = None
+        self._data: OrderedDict = OrderedDict()
+        self._lock = threading.Lock()
+
+    def key(self, T: Any, p: Any, x: Any) -> Optional[Tuple[Hashable, ...]]:
+        """
+        Returns:
+            quantized state: index of bin of width 'tol' per variable, 
+            exact value if tol is zero
+            OR
+            None if any argument is not a plain number, e.g. an array 
+            or a Dual
+        """
+        key = []
+        for v, tol in zip((T, p, x), self.tol):
+            if v is None:
+                key.append(None)
+            elif isinstance(v, (int, float)) and not isinstance(v, bool):
+                if tol > 0.:
+                    if not -1e300 < v < 1e300:    # NaN or infinite
+                        return None
+                    key.append(round(v / tol))
+                else:
+                    key.append(float(v))
+            else:
+                return None
+        return tuple(key)
+
+    def lookup(self, key: Tuple[Hashable, ...], refs: Tuple[Any, ...], 
+               func: Callable[..., Any], *args: Any) -> Any:
+        """
+        Returns:
+            cached value of 'key', or func(*args) which is then cached.
+            The cache is cleared if reference values 'refs' differ from
+            the ones of the cached values
+        """
+        with self._lock:
+            try:
+                same_refs = bool(refs == self.refs)
+            except ValueError:
+                same_refs = False
+            if not same_refs:
+                self._data.clear()
+                self.refs = refs
+            elif key in self._data:
+                self._data.move_to_end(key)
+                self.hits += 1
+                telemetry.count('memo_hit')
+                return self._data[key]
+            self.misses += 1
+        telemetry.count('memo_miss')
+        value = func(*args)
+        with self._lock:
+            self._data[key] = value
+            if len(self._data) > self.maxsize:
+                self._data.popitem(last=False)
+        return value
+
+    def clear(self) -> None:
+        with self._lock:
+            self._data.clear()
+            self.refs = None
+
+    def stats(self) -> Dict[str, int]:
+        with self._lock:
+            return {'hits': self.hits, 'misses': self.misses, 
+                    'size': len(self._data), 'maxsize': self.maxsize}
 
 
 class Property(Parameter):
@@ -52,6 +156,18 @@ class Property(Parameter):
       - calc(T, p, x) is the implementation of the dependency of a 
         property of temperature T, pressure p or spare parameter x
 
+      - calc_vec(T, p, x) is an optional vectorized variant of calc()
+        operating on broadcast arrays, it is employed by eval_batch()
+
+      - calc_grad(T, p, x) is an optional analytic gradient of calc(), 
+        it returns value and gradient [dy/dT, dy/dp, dy/dx]. Without 
+        calc_grad, grad() differentiates calc() with dual numbers and 
+        falls back to finite differences
+
+      - a number assigned to calc makes the property constant: 
+        __call__() returns the stored value without calling a function 
+        and 'constant_value' exposes it to compiled kernels
+
       - Function self.__call__() must NOT be overwritten
     """
 
@@ -63,7 +179,9 @@ class Property(Parameter):
                  val: Optional[Union[float, Iterable[float]]] = None,
                  ref: Optional[Union[float, Iterable[float]]] = None,
                  comment: Optional[str] = None,
-                 calc: Optional[Callable[..., float]] = None) -> None:
+                 calc: Optional[Union[Callable[..., float], float]] = None,
+                 calc_vec: Optional[Callable[..., np.ndarray]] = None
+                 ) -> None:
         
         super().__init__(identifier=identifier, unit=unit, absolute=absolute,
                          latex=latex, val=val, ref=ref, comment=comment)
@@ -90,9 +208,78 @@ class Property(Parameter):
         
         if calc is None:
             calc = lambda T, p, x: 1.
-        self.calc = calc
+        self.calc_vec: Optional[Callable[..., np.ndarray]] = None
+        self.calc_grad: Optional[Callable[..., Tuple[float, 
+                                                     np.ndarray]]] = None
+        self.calc = calc     # constant 'calc' sets 'calc_vec', 'calc_grad'
+        if calc_vec is not None:
+            self.calc_vec = calc_vec
 
         self.regression_coefficients: Optional[Iterable[float]] = None
+        self.regression_range: Optional[Tuple[float, float]] = None
+        self.regression_max_rel_error: Optional[float] = None
+
+    def memoize(self, maxsize: Optional[int] = 1024,
+                tol: Tuple[float, float, float] = (0., 0., 0.),
+                depends: Iterable['Property'] = ()) -> None:
+        """
+        Enables or disables memoization of scalar calls of __call__(). 
+        Repeated state points, e.g. of Picard iterations or of mixing 
+        rules querying their components, are served from a bounded 
+        LRU cache
+
+        Args:
+            maxsize:
+                maximum number of cached state points, 
+                None or 0: memoization is disabled and cache is removed
+
+            tol:
+                quantization of (T, p, x): states in the same bin of 
+                width tol[i] return the cached value of the first call. 
+                The error is bounded by the change of the property 
+                within one bin. Zero tolerance means exact match 
+
+            depends:
+                properties called by 'calc', e.g. k, c_p and rho of 
+                thermal diffusivity a = k / (c_p * rho)
+
+        Note:
+            - cache is cleared if 'calc' or the reference values of the 
+              property or of its T, p or x are changed, or if 'calc' or
+              one of these reference values of a property in 'depends' 
+              is changed
+            - array arguments and dual numbers are not cached; 
+              eval_batch() is not affected
+            - hits and misses are counted in 'memo_stats' and reported 
+              to an active telemetry.Telemetry as 'memo_hit' and 
+              'memo_miss'
+        """
+        assert len(tol) == 3 and all(t >= 0. for t in tol), str(tol)
+        self._memo = _Memo(maxsize, tol) if maxsize else None
+        self._memo_depends = tuple(depends) if maxsize else ()
+
+    def _memo_refs(self) -> Tuple[Any, ...]:
+        """
+        Returns:
+            function and reference values the cached values depend on,
+            including those of the properties in 'depends' of memoize()
+        """
+        return (self._calc, self._constant, self.ref, self.T.ref, 
+                self.p.ref, None if self.x is None else self.x.ref) + \
+            tuple(prop._memo_refs() 
+                  for prop in getattr(self, '_memo_depends', ()))
+
+    @property
+    def memo_stats(self) -> Optional[Dict[str, int]]:
+        """
+        Returns:
+            numbers of hits, misses and cached state points and maximum 
+            cache size
+            OR
+            None if memoization is disabled
+        """
+        memo = getattr(self, '_memo', None)
+        return None if memo is None else memo.stats()
 
     def plot(self, title: str = '') -> None:
         if isinstance(self.T, Parameter):
@@ -129,16 +316,13 @@ class Property(Parameter):
                 plt.grid()
                 plt.show()
 
-    def calc(self, 
-             T: Optional[Union[float, Iterable[float]]] = 0., 
-             p: Optional[Union[float, Iterable[float]]] = 0., 
-             x: Optional[Union[float, Iterable[float]]] = 0.
-    ) -> Optional[Union[float, Iterable[float]]]:
+    @property
+    def calc(self) -> Callable[..., Optional[Union[float, Iterable[float]]]]:
         """
-        This function SHOULD be overwritten in derived classes.
-        It returns the actual value(s) as a placeholder 
+        This function SHOULD be assigned in derived classes.
+        It computes the actual value(s) of the property
 
-        Args:
+        Args of assigned function:
             T:
                 Temperature as scalar or as 1D array
             p:
@@ -146,18 +330,89 @@ class Property(Parameter):
             x:
                 Spare variable as scalar or as 1D array
 
-        Returns:
+        Returns of assigned function:
             Approximation of value as function of T, p and x
             if T, p and x are scalars, the method returns a scaler.
             Otherwise a 1D array will be returned
 
+        Note:
+            Assigning a new function resets the vectorized kernel 
+            'calc_vec' and the analytic gradient 'calc_grad', because 
+            they belong to the replaced function.
+
+            Assigning a number instead of a function defines a constant
+            property, see 'constant_value'
+
         Example:
             class X():
                 def __init__(self):
                     self.abc = Property('abc', 'kg/m3')
                     self.abc.calc = lambda T, p, x=0: 2 + 3*T - 2*p
+                    self.k = Property('k', 'W/m/K')
+                    self.k.calc = 25.
+        """
+        return self._calc
+
+    @calc.setter
+    def calc(self, 
+             value: Union[Callable[..., Optional[Union[float, 
+                                                       Iterable[float]]]], 
+                          float]
+             ) -> None:
+        if getattr(self, '_memo', None) is not None:
+            self._memo.clear()
+        if isinstance(value, (int, float, np.number)) and \
+                not isinstance(value, bool):
+            constant = float(value)
+            self._constant: Optional[float] = constant
+            self._calc = lambda T=0., p=0., x=0.: constant
+            self.calc_vec = lambda T, p, x: np.full(
+                np.broadcast(T, p, x).shape, constant)
+            self.calc_grad = lambda T, p, x: (constant, np.zeros(3))
+        else:
+            self._constant = None
+            self._calc = value
+            self.calc_vec = None
+            self.calc_grad = None
+
+    @property
+    def is_constant(self) -> bool:
+        """
+        Returns:
+            True if a number has been assigned to 'calc'
+        """
+        return self._constant is not None
+
+    @property
+    def constant_value(self) -> Optional[float]:
         """
-        return self.val
+        Returns:
+            value of constant property as plain float, e.g. for passing 
+            to compiled kernels
+            OR
+            None if property is not constant
+        """
+        return self._constant
+
+    def to_number(self, 
+                  T: Optional[float] = None, 
+                  p: Optional[float] = None, 
+                  x: Optional[float] = None) -> Optional[float]:
+        """
+        Args:
+            T, p, x:
+                state at which a non-constant property is evaluated, 
+                see __call__()
+
+        Returns:
+            constant value or value at state (T, p, x) as plain float 
+            OR
+            None if value is invalid
+        """
+        if self._constant is not None:
+            return self._constant
+        value = _to_float(self.__call__(T, p, x))
+        return None if np.isnan(value) else value
 
     def regression_fit(self, 
             T_range: Optional[Tuple[float, float]] = None,
@@ -197,12 +452,23 @@ class Property(Parameter):
         Returns:
             regression coefficients, length of list is: order+1
             OR
-            None if desired 'order' is invalid 
+            None if desired 'order' is invalid or property is invalid
+            in T_range
+
+        Note:
+            - order 1 interpolates the end points of T_range, higher 
+              orders are least squares fits at 4*(order+1) Chebyshev 
+              points of T_range
+            - the fit is a function of T only, p and x are fixed to the
+              lower bounds of p_range and x_range
+            - the maximum relative error at the midpoints between the
+              fit points is stored in 'regression_max_rel_error', the
+              temperature range in 'regression_range'
         """
         dT, dp, dx = 100., 1e5, 1.  # default span of ranges
         
         if T_range is None:
-            T_range = [self.T.ref, self.T_ref + dT]
+            T_range = [self.T.ref, self.T.ref + dT]
         if p_range is None:
             p_range = [self.p.ref, self.p.ref + dp]
         if x_range is None:
@@ -216,6 +482,8 @@ class Property(Parameter):
                 order = 1
             elif order.startswith('qua'):
                 order = 2
+            elif order.startswith('cub'):
+                order = 3
             else:
                 order = 1
         assert T_range[1] - T_range[0] > 1e-20, str(T_range)
@@ -223,55 +491,80 @@ class Property(Parameter):
         assert x_range[1] - x_range[0] > 1e-20, str(x_range)
 
         self.regression_coefficients = None
+        self.regression_range = None
+        self.regression_max_rel_error = None
+        if not isinstance(order, (int, np.integer)) or order < 1:
+            return None
+
+        T0, T1 = float(T_range[0]), float(T_range[1])
         if order == 1:
-            y0 = self.calc(T_range[0], p_range[0], x_range[0])
-            y1 = self.calc(T_range[1], p_range[0], x_range[0])  # !!! [0]
-            c1 = (y1 - y0) / (T_range[1] - T_range[0])           
-            c0 = y0 - c1 * T_range[0]
-            self.regression_coefficients = [c0, c1]
+            T = np.array([T0, T1])
         else:
-            # TODO add regression for higher orders 
-            assert order < 2, str(order)
-        
+            # Chebyshev-Lobatto points reduce the Runge effect of the 
+            # least squares fit, the fit is not a minimax approximation
+            n = 4 * (order + 1)
+            T = 0.5 * (T0 + T1) - 0.5 * (T1 - T0) * \
+                np.cos(np.pi * np.arange(n) / (n - 1))
+        T_mid = 0.5 * (T[1:] + T[:-1])
+        y, valid = self.eval_batch(np.append(T, T_mid), p_range[0], 
+                                   x_range[0])
+        if not valid.all():
+            return None
+        y, y_mid = y[:T.size], y[T.size:]
+
+        if order == 1:
+            c1 = (y[1] - y[0]) / (T1 - T0)
+            c0 = y[0] - c1 * T0
+            coefficients = [c0, c1]
+        else:
+            # fit in scaled domain [-1, 1], then convert to powers of T
+            poly = np.polynomial.Polynomial.fit(T, y, order)
+            coefficients = list(poly.convert().coef)
+            coefficients += [0.] * (order + 1 - len(coefficients))
+        self.regression_coefficients = [float(c) for c in coefficients]
+        self.regression_range = (T0, T1)
+
+        approx = self.regression_prediction(T_mid)
+        scale = np.maximum(np.abs(y_mid), 1e-20)
+        self.regression_max_rel_error = float(np.max(np.abs(approx - y_mid)
+                                                     / scale))
         return self.regression_coefficients
 
     def regression_prediction(self, 
-                              T: Optional[float] = None, 
+                              T: Optional[Union[float, 
+                                                Iterable[float]]] = None, 
                               p: Optional[float] = None,
-                              x: Optional[float] = None) -> float:
+                              x: Optional[float] = None
+                              ) -> Union[float, np.ndarray]:
         """
-        Linear approximation:
+        Polynomial approximation, see regression_fit():
             y = c0 + c1*T                     for T in [T0, T1]
             y = c0 + c1*T + c2*T^2            for T in [T0, T1]
             y = c0 + c1*T + c2*T^2 + c3*T^3   for T in [T0, T1]
             
         Args:
             T:
-                Temperature
+                Temperature as float or as array
                 If None, the value of T.ref will be used
+
+            p, x:
+                not used, the fit is a function of T only
  
         Returns:
-            approximation of property
+            approximation of property, float or array of shape of T
         """        
         assert self.regression_coefficients is not None, \
-            'call self.regression_coeffients() before linear_approximation()'
+            'call self.regression_fit() before regression_prediction()'
 
         if T is None:
             T = self.T.ref
-        if p is None:
-            p = self.p.ref
-        if x is None:
-            x = self.x.ref
-                        
-        y = self.regression_coefficients[0]   
-        
-        if len(self.regression_coefficients) > 1:
-            return y + self.regression_coefficients[1] * T
-        if len(self.regression_coefficients) > 2:
-            return y + self.regression_coefficients[2] * T*T
-        if len(self.regression_coefficients) > 3:
-            return y + self.regression_coefficients[3] * T*T*T
+        if np.ndim(T) > 0:
+            T = np.asfarray(T)
 
+        # Horner scheme
+        y = 0.
+        for c in reversed(self.regression_coefficients):
+            y = y * T + c
         return y
 
     def __call__(self, 
@@ -298,18 +591,250 @@ class Property(Parameter):
             if T, p and x are scalars, then method returns a scalar.
             Otherwise a 1D array will be returned
         """
+        if telemetry.ACTIVE is not None:
+            telemetry.ACTIVE.count('property', int(np.size(T)) or 1)
+        if self._constant is not None:
+            return self._constant
         if T is None:
             T = self.T.ref
         if p is None:
             p = self.p.ref
         if x is None and self.x is not None:
             x = self.x.ref
+
+        memo = getattr(self, '_memo', None)
+        if memo is not None:
+            key = memo.key(T, p, x)
+            if key is not None:
+                return memo.lookup(key, self._memo_refs(), self.calc, 
+                                   T, p, x)
             
         return self.calc(T, p, x)
     
+    def eval_batch(self, 
+                   T: Optional[Union[float, Iterable[float]]] = None, 
+                   p: Optional[Union[float, Iterable[float]]] = None, 
+                   x: Optional[Union[float, Iterable[float]]] = None
+                   ) -> Tuple[np.ndarray, np.ndarray]:
+        """
+        Evaluates property for arrays of T, p and x in a single call.
+        The arguments are broadcast against each other like NumPy 
+        operands.
+
+        If the vectorized kernel 'calc_vec' is assigned, it is called 
+        once with the broadcast arrays. Otherwise (or if the kernel 
+        fails) calc() is called for each element
+
+        Args:
+            T:
+                Temperature as float or as array.
+                If None, the value of T.ref will be used
+            p:
+                Pressure as float or as array
+                If None, the value of p.ref will be used
+            x:
+                Spare variable as float or as array
+                If None, the value of x.ref will be used
+
+        Returns:
+            y:
+                property values, shape of broadcast T, p and x. 
+                Invalid elements are NaN
+            valid:
+                boolean array of same shape, False if element is invalid
+
+        Example:
+            y, valid = water.rho.eval_batch(T=np.linspace(280, 360, 10**6))
+        """
+        if T is None:
+            T = self.T.ref
+        if p is None:
+            p = self.p.ref
+        if x is None and self.x is not None:
+            x = self.x.ref
+        if x is None:
+            x = 0.
+        T, p, x = np.broadcast_arrays(np.asfarray(T), np.asfarray(p), 
+                                      np.asfarray(x))
+        if telemetry.ACTIVE is not None:
+            telemetry.ACTIVE.count('property', T.size)
+        y = None
+        if self.calc_vec is not None:
+            try:
+                y = np.array(np.broadcast_to(
+                    np.asfarray(self.calc_vec(T, p, x)), T.shape))
+            except Exception:
+                y = None
+
+        if y is None:
+            y = np.empty(T.shape)
+            for i in np.ndindex(T.shape):
+                try:
+                    y[i] = _to_float(self.calc(T[i], p[i], x[i]))
+                except Exception:
+                    y[i] = np.nan
+
+        valid = np.isfinite(y)
+        y[~valid] = np.nan
+
+        return y, valid
+    
+    def _grad_exact(self, T: float, p: float, 
+                    x: float) -> Optional[Tuple[float, np.ndarray]]:
+        """
+        Returns:
+            value and gradient from 'calc_grad' or from evaluation of 
+            calc() with dual numbers
+            OR
+            None if calc() is not differentiable with dual numbers
+        """
+        if self.calc_grad is not None:
+            try:
+                val, grad = self.calc_grad(T, p, x)
+                if val is not None:
+                    return float(val), np.asfarray(grad)
+            except Exception:
+                pass
+        try:
+            y = self.calc(*seed(T, p, x))
+        except Exception:
+            return None
+        if isinstance(y, np.ndarray) and y.dtype == object and y.size == 1:
+            y = y.item()
+
+        # plain numbers are not trusted: an exception might have been 
+        # swallowed inside of calc() 
+        if not isinstance(y, Dual):
+            return None
+        return float(y.val), y.der
+
+    def grad(self, 
+             T: Optional[float] = None, 
+             p: Optional[float] = None, 
+             x: Optional[float] = None,
+             steps: Tuple[float, float, float] = (0.1, 1., 1e-3)
+             ) -> Tuple[Optional[float], Optional[np.ndarray]]:
+        """
+        Value and gradient of property from a single evaluation
+
+        Args:
+            T:
+                Temperature as float.
+                If None, the value of T.ref will be used
+            p:
+                Pressure as float
+                If None, the value of p.ref will be used
+            x:
+                Spare variable as float
+                If None, the value of x.ref will be used
+            steps:
+                step sizes of forward differences in T, p and x, 
+                only used if calc() is not differentiable with dual
+                numbers
+
+        Returns:
+            value and gradient [dy/dT, dy/dp, dy/dx] 
+            OR
+            (value, None) or (None, None) if invalid
+
+        Example:
+            rho, (drho_dT, drho_dp, drho_dx) = water.rho.grad(C2K(20), 1e5)
+        """
+        if T is None:
+            T = self.T.ref
+        if p is None:
+            p = self.p.ref
+        if x is None:
+            x = self.x.ref if self.x is not None and \
+                self.x.ref is not None else 0.
+
+        exact = self._grad_exact(T, p, x)
+        if exact is not None:
+            return exact
+
+        try:
+            y0 = self.calc(T, p, x)
+            if y0 is None:
+                return None, None
+            y0 = _to_float(y0)
+            args = np.array([T, p, x], dtype=float)
+            grad = np.empty(3)
+            for i in range(3):
+                shifted = args.copy()
+                shifted[i] += steps[i]
+                y1 = self.calc(*shifted)
+                if y1 is None:
+                    return y0, None
+                grad[i] = (_to_float(y1) - y0) / steps[i]
+        except Exception:
+            return None, None
+        return y0, grad
+
+    def derivative(self, T: float, p: float, x: float, wrt: str = 'T',
+                   step: Optional[float] = None) -> Optional[float]:
+        """
+        Partial derivative of property
+
+        Args:
+            T:
+                Temperature as float
+            p:
+                Pressure as float
+            x:
+                Spare variable as float
+            wrt:
+                independent variable: 'T', 'p' or 'x'
+            step:
+                step size of forward difference, only used if calc() 
+                is not differentiable with dual numbers. If None, the
+                default of grad() is used
+
+        Returns:
+            partial derivative dy/dT, dy/dp or dy/dx
+            OR
+            None if invalid
+        """
+        i = 'Tpx'.index(wrt)
+        exact = self._grad_exact(T, p, x)
+        if exact is not None:
+            return float(exact[1][i])
+
+        if step is None:
+            step = (0.1, 1., 1e-3)[i]
+        args = [T, p, x]
+        try:
+            y0 = self.calc(T, p, x)
+            args[i] += step
+            y1 = self.calc(*args)
+            if y0 is None or y1 is None:
+                return None
+            return (_to_float(y1) - _to_float(y0)) / step
+        except Exception:
+            return None
+
     def simulate(self, range_key: Optional[str] = None, 
                  size: Optional[Union[int, Tuple[int]]] = None, 
-                 plot: bool = False) -> bool:   
+                 plot: bool = False,
+                 seed: Optional[int] = None,
+                 stream: int = 0) -> bool:   
+        """
+        Simulates value of property and of T, p and x, see 
+        Parameter.simulate()
+
+        Args:
+            range_key:
+                key of the range bounding the output
+            size:
+                size of output arrays
+            plot:
+                plot simulated array(s) if True
+            seed:
+                key of reproducible random generator, a single generator
+                is shared by property and T, p and x
+            stream:
+                index of random stream, e.g. worker index
+        """
+        rng = make_rng(seed, stream) if seed is not None else None
         if range_key is None:
             range_key = 'calibrated'
         if range_key not in self.ranges:
@@ -319,23 +844,23 @@ class Property(Parameter):
             s = f"property('{self.identifier}')"
             print(rf'\n+++ Simulate {s}:')
         self.val = Parameter.simulate(self, range_key=range_key, size=size, 
-                                      plot=plot)
+                                      plot=plot, rng=rng)
         
         if self.T is not None:
             if plot:
                 print('\n+++ Simulate', s + '.T:')
             self.T.val = self.T.simulate(range_key=range_key, size=size, 
-                                         plot=plot)
+                                         plot=plot, rng=rng)
         if self.p is not None:
             if plot:
                 print('\n+++ Simulate', s + '.p:')
             self.p.val = self.p.simulate(range_key=range_key, size=size, 
-                                         plot=plot)
+                                         plot=plot, rng=rng)
         if self.x is not None:
             if plot:
                 print('\n+++ Simulate', s + '.x:')
             self.x.val = self.x.simulate(range_key=range_key, size=size, 
-                                         plot=plot)
+                                         plot=plot, rng=rng)
         
         return (self.val is not None 
                 and (self.T is None or self.T.val is not None)  
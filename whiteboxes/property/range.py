@@ -26,7 +26,8 @@ __all__ = ['Range',
            'is_bound_absolute',
            'is_bound_relative_to_reading', 'is_bound_relative_to_full_scale',
            'is_range_absolute',
-           'is_range_relative_to_reading', 'is_range_relative_to_full_scale',]
+           'is_range_relative_to_reading', 'is_range_relative_to_full_scale',
+           'make_rng', 'random_in_range',]
 
 import numpy as np
 np.random.seed(19680801)
@@ -35,6 +36,83 @@ import matplotlib.pyplot as plt
 from typing import Iterable, Optional, Tuple, Union
     
 
+def make_rng(seed: Optional[int] = None, 
+             stream: int = 0) -> np.random.Generator:
+    """
+    Creates reproducible random generator based on the counter-based 
+    bit generator Philox. Independent streams for parallel workers are 
+    obtained from the same seed with different 'stream' indices, each 
+    stream is a jump of 2^128 draws ahead
+    
+    Args:
+        seed:
+            key of generator. If None, a random key is used
+            
+        stream:
+            index of stream, e.g. index of worker process
+
+    Returns:
+        random generator
+
+    Example:
+        rngs = [make_rng(seed=42, stream=i) for i in range(n_workers)]
+    """
+    bit_generator = np.random.Philox(seed)
+    if stream:
+        bit_generator = bit_generator.jumped(stream)
+    return np.random.Generator(bit_generator)
+
+
+def random_in_range(lo: Union[float, np.ndarray], 
+                    up: Union[float, np.ndarray], 
+                    distr: Optional[str] = None,
+                    size: Union[None, int, Tuple[int]] = None,
+                    rng: Optional[np.random.Generator] = None) \
+        -> Union[float, np.ndarray]:
+    """
+    Generates random data in [lo, up] in a single draw, lower and 
+    upper bounds can be arrays of per-element bounds. The distributions
+    are the same as in Range.simulate()
+
+    Args:
+        lo:
+            absolute lower bound(s)
+
+        up:
+            absolute upper bound(s)
+
+        distr:
+            distribution: 'cont', 'gauss' or other. If None, 'gauss' 
+            is used
+
+        size:
+            size of output array. If None, the broadcast shape of lo 
+            and up is used; a float is returned if lo and up are scalars 
+
+        rng:
+            random generator, e.g. from make_rng(). If None, the global 
+            NumPy random state is used
+            
+    Returns:
+        random float or random array
+    """
+    if distr is None:
+        distr = 'gauss'
+    lo, up = np.asfarray(lo), np.asfarray(up)
+    if size is None:
+        size = np.broadcast(lo, up).shape or None
+    source = np.random if rng is None else rng
+
+    if distr.lower().startswith(('cont', 'flat', 'samp')):
+        y = lo + (up - lo) * source.random(size=size)
+    elif distr.lower().startswith(('gauss', 'norm', 'bell')):
+        y = source.normal(loc=(up+lo)/2, scale=np.abs((up-lo)/3.0), 
+                          size=size)
+    else:
+        y = lo + (up - lo) * source.normal(size=size)
+    return float(y) if np.ndim(y) == 0 else y
+
+
 def percentage_of_bound(bound: Union[None, float, int, str]) \
         -> Optional[float]:
     """
@@ -482,7 +560,9 @@ class Range(object):
         
     def simulate(self, size: Union[None, int, Tuple[int]] = None,
                  full_scale: Optional['Range'] = None,
-                 plot: bool = False) -> Union[None, float, np.ndarray]:
+                 plot: bool = False,
+                 rng: Optional[np.random.Generator] = None) \
+            -> Union[None, float, np.ndarray]:
         """
         Generates random data in the range [self.lo, self.up] for the 
         following distributions:
@@ -503,6 +583,10 @@ class Range(object):
 
             plot:
                 if True, output and histogram is plotted
+
+            rng:
+                random generator, see make_rng(). If None, the global
+                NumPy random state is used
                                 
         Returns:
             random array of dimension of size if size is not None
@@ -513,11 +597,11 @@ class Range(object):
             
         """
         if full_scale is not None:
-            rng = relative_to_absolute_range(Range(self.lo, self.up, 
-                                                   self.distr), full_scale)
-            if rng is None:
+            abs_range = relative_to_absolute_range(Range(self.lo, self.up, 
+                                                 self.distr), full_scale)
+            if abs_range is None:
                 return None
-            lo, up, distr = rng.lo, rng.up, rng.distr
+            lo, up, distr = abs_range.lo, abs_range.up, abs_range.distr
         else:
             lo, up, distr = self.lo, self.up, self.distr
             
@@ -540,15 +624,7 @@ class Range(object):
             print('??? Range.simulate(), err:', err,'up:', up)
             up = 1.
   
-        if distr.lower().startswith(('cont', 'flat', 'samp')):
-            y_ = np.random.random(size=size)
-            y = lo + (up - lo) * y_
-        elif distr.lower().startswith(('gauss', 'norm', 'bell')):
-            y = np.random.normal(loc=(up+lo)/2, scale=np.abs((up-lo)/3.0), 
-                                 size=size)            
-        else:
-            y_ = np.random.normal(size=size)
-            y = lo + (up - lo) * y_
+        y = random_in_range(lo, up, distr, size=size, rng=rng)
              
         if plot:
             n = np.prod(size)
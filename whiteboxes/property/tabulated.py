@@ -0,0 +1,352 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-05-02 DWW
+"""
+
+__all__ = ['PropertyTable']
+
+import hashlib
+import numpy as np
+import os
+from scipy.interpolate import RectBivariateSpline
+from tempfile import gettempdir
+from typing import Callable, Iterable, Optional, Tuple, Union
+
+
+class PropertyTable(object):
+    """
+    Precomputed lookup table of a property as function of temperature
+    and pressure. The table replaces expensive calls of e.g. CoolProp
+    in inner loops
+
+                 p ^
+                   |   o-----o-----o-----o
+                   |   |  +  |  +  |  +  |     o: grid point (exact value)
+                   |   o-----o-----o-----o     +: test point (cell center)
+                   |   |  +  |  +  |  +  |
+                   |   o-----o-----o-----o
+                   +----------------------> T
+
+    - grid is refined until the relative interpolation error at the cell
+      centers is less than 'tol' or the maximum grid size is reached
+    - the achieved error is stored in 'max_rel_error'
+    - the table is built lazily at the first call
+    - tables are persisted as .npz-files, other processes load them
+      instead of rebuilding
+    - outside of the (T, p)-box the exact function is called
+
+    Note:
+        The spare parameter 'x' is ignored, the exact function must
+        not depend on x
+    """
+
+    def __init__(self,
+                 func: Callable[..., Optional[float]],
+                 T_range: Tuple[float, float],
+                 p_range: Tuple[float, float],
+                 identifier: str = 'property',
+                 func_vec: Optional[Callable[..., np.ndarray]] = None,
+                 tol: float = 1e-4,
+                 degree: int = 3,
+                 n_init: Tuple[int, int] = (9, 9),
+                 n_max: Tuple[int, int] = (513, 257),
+                 path: Optional[str] = None,
+                 silent: bool = True) -> None:
+        """
+        Args:
+            func:
+                exact function of (T, p, x) for scalar arguments,
+                returns None if parameters are invalid
+
+            T_range:
+                lower and upper bound of temperature [K]
+
+            p_range:
+                lower and upper bound of pressure [Pa]
+
+            identifier:
+                identifier of table, part of file name
+
+            func_vec:
+                optional exact function of (T, p, x) for array arguments
+
+            tol:
+                upper bound of relative interpolation error [/]
+
+            degree:
+                degree of spline: 3 (bicubic) or 1 (bilinear, monotone)
+
+            n_init:
+                initial number of grid points in T- and p-direction
+
+            n_max:
+                maximum number of grid points in T- and p-direction
+
+            path:
+                directory of table files; if None, temporary directory
+                is used. If path is '', the table is not persisted
+
+            silent:
+                if False, then build and load of table are reported
+        """
+        assert degree in (1, 3), str(degree)
+        assert T_range[0] < T_range[1] and p_range[0] < p_range[1]
+
+        self.func = func
+        self.func_vec = func_vec
+        self.T_range = (float(T_range[0]), float(T_range[1]))
+        self.p_range = (float(p_range[0]), float(p_range[1]))
+        self.identifier = identifier
+        self.tol = tol
+        self.degree = degree
+        self.n_init = (max(n_init[0], degree + 1), max(n_init[1], degree + 1))
+        self.n_max = n_max
+        self.path = gettempdir() if path is None else path
+        self.silent = silent
+
+        self.T_grid: Optional[np.ndarray] = None
+        self.p_grid: Optional[np.ndarray] = None
+        self.values: Optional[np.ndarray] = None
+        self.max_rel_error: float = np.inf
+        self._spline: Optional[RectBivariateSpline] = None
+        self._failed = False
+
+    def __str__(self) -> str:
+        if self._failed:
+            return self.identifier + ': build failed, exact function used'
+        if self._spline is None:
+            return self.identifier + ': not built'
+        return '{}: {}x{} points, max rel error: {:.2e} (tol: {:.0e})' \
+            .format(self.identifier, self.T_grid.size, self.p_grid.size,
+                    self.max_rel_error, self.tol)
+
+    @property
+    def file(self) -> Optional[str]:
+        """
+        Returns:
+            full path to table file
+            OR
+            None if table is not persisted
+        """
+        if not self.path:
+            return None
+        key = repr((self.identifier, self.T_range, self.p_range, self.tol,
+                    self.degree, self.n_init, self.n_max))
+        hash_ = hashlib.md5(key.encode()).hexdigest()[:12]
+        return os.path.join(self.path,
+                            'table_' + self.identifier + '_' + hash_ + '.npz')
+
+    def _exact(self, T: np.ndarray, p: np.ndarray) -> np.ndarray:
+        """
+        Evaluates exact function on broadcast arrays, NaN if invalid
+        """
+        T, p = np.broadcast_arrays(np.asfarray(T), np.asfarray(p))
+        if self.func_vec is not None:
+            try:
+                y = np.asfarray(self.func_vec(T, p, 0.))
+                return np.array(np.broadcast_to(y, T.shape))
+            except Exception:
+                pass
+        y = np.full(T.shape, np.nan)
+        for i in np.ndindex(T.shape):
+            try:
+                val = self.func(float(T[i]), float(p[i]), 0.)
+                if val is not None:
+                    y[i] = float(val)
+            except Exception:
+                pass
+        return y
+
+    def _fit(self, T: np.ndarray, p: np.ndarray,
+             values: np.ndarray) -> RectBivariateSpline:
+        return RectBivariateSpline(T, p, values, kx=self.degree,
+                                   ky=self.degree, s=0)
+
+    def build(self) -> 'PropertyTable':
+        """
+        Builds table by grid refinement until error bound is satisfied
+
+        Returns:
+            self
+
+        Raises:
+            ValueError if exact function is invalid at any grid point
+        """
+        nT, np_ = self.n_init
+        while True:
+            T = np.linspace(*self.T_range, nT)
+            p = np.linspace(*self.p_range, np_)
+            values = self._exact(T[:, np.newaxis], p[np.newaxis, :])
+            if not np.isfinite(values).all():
+                raise ValueError(self.identifier +
+                    ': exact function invalid in (T, p)-range of table')
+            spline = self._fit(T, p, values)
+
+            # compare interpolation with exact values at cell centers
+            T_mid = 0.5 * (T[1:] + T[:-1])
+            p_mid = 0.5 * (p[1:] + p[:-1])
+            exact = self._exact(T_mid[:, np.newaxis], p_mid[np.newaxis, :])
+            approx = spline(T_mid, p_mid)
+            scale = np.maximum(np.abs(exact), 1e-20)
+            with np.errstate(invalid='ignore'):
+                rel_error = np.abs(approx - exact) / scale
+            max_rel_error = float(np.nanmax(rel_error))
+
+            done = max_rel_error <= self.tol
+            if not done:
+                # refine axis with larger error contribution
+                err_T = np.nanmax(rel_error, axis=1).mean()
+                err_p = np.nanmax(rel_error, axis=0).mean()
+                nT_new = 2 * nT - 1 if nT < self.n_max[0] and \
+                    (err_T >= err_p or np_ >= self.n_max[1]) else nT
+                np_new = 2 * np_ - 1 if np_ < self.n_max[1] and \
+                    (err_p >= err_T or nT >= self.n_max[0]) else np_
+                if (nT_new, np_new) == (nT, np_):
+                    if not self.silent:
+                        print('!!! ' + self.identifier + ': tol not '
+                              'reached, max rel error:', max_rel_error)
+                    done = True
+                nT, np_ = min(nT_new, self.n_max[0]), \
+                    min(np_new, self.n_max[1])
+            if done:
+                break
+
+        self.T_grid, self.p_grid, self.values = T, p, values
+        self.max_rel_error = max_rel_error
+        self._spline = spline
+        if not self.silent:
+            print('+++ built ' + str(self))
+        return self
+
+    def save(self) -> bool:
+        """
+        Writes table atomically to file, see property 'file'
+
+        Returns:
+            False if table is not persisted or writing failed
+        """
+        if self.file is None or self._spline is None:
+            return False
+        tmp = self.file + '.' + str(os.getpid()) + '.tmp.npz'
+        try:
+            np.savez(tmp, T=self.T_grid, p=self.p_grid, values=self.values,
+                     max_rel_error=self.max_rel_error)
+            os.replace(tmp, self.file)
+        except OSError:
+            return False
+        return True
+
+    def load(self) -> bool:
+        """
+        Reads table from file, see property 'file'
+
+        Returns:
+            False if file does not exist or is not readable
+        """
+        if self.file is None or not os.path.isfile(self.file):
+            return False
+        try:
+            with np.load(self.file) as data:
+                T, p, values = data['T'], data['p'], data['values']
+                max_rel_error = float(data['max_rel_error'])
+        except (OSError, KeyError, ValueError):
+            return False
+        self.T_grid, self.p_grid, self.values = T, p, values
+        self.max_rel_error = max_rel_error
+        self._spline = self._fit(T, p, values)
+        if not self.silent:
+            print('+++ loaded ' + str(self))
+        return True
+
+    def _ensure(self) -> bool:
+        """
+        Loads or builds table at first call
+
+        Returns:
+            False if table could not be built
+        """
+        if self._spline is None and not self._failed:
+            if not self.load():
+                try:
+                    self.build()
+                except ValueError as e:
+                    if not self.silent:
+                        print('!!! ' + str(e))
+                    self._failed = True
+                    return False
+                self.save()
+        return not self._failed
+
+    def evaluate(self, T: Union[float, Iterable[float]],
+                 p: Union[float, Iterable[float]],
+                 x: Union[float, Iterable[float]] = 0.) -> np.ndarray:
+        """
+        Args:
+            T:
+                temperature [K]
+            p:
+                pressure [Pa]
+            x:
+                dummy parameter [/]
+
+        Returns:
+            interpolated values, array of broadcast shape of T and p.
+            Points outside of table are computed with exact function
+        """
+        if not self._ensure():
+            return self._exact(T, p)
+        T, p = np.broadcast_arrays(np.asfarray(T), np.asfarray(p))
+        inside = (T >= self.T_range[0]) & (T <= self.T_range[1]) & \
+                 (p >= self.p_range[0]) & (p <= self.p_range[1])
+        y = np.empty(T.shape)
+        y[inside] = self._spline.ev(T[inside], p[inside])
+        if not inside.all():
+            y[~inside] = self._exact(T[~inside], p[~inside])
+        return y
+
+    def __call__(self, T: Union[float, Iterable[float]],
+                 p: Union[float, Iterable[float]],
+                 x: Union[float, Iterable[float]] = 0.) \
+            -> Optional[Union[float, np.ndarray]]:
+        """
+        Same as evaluate(), but returns float for scalar arguments and
+        None if value is invalid (convention of Property.calc)
+        """
+        if np.ndim(T) == 0 and np.ndim(p) == 0:
+            if self._ensure() and \
+                    self.T_range[0] <= T <= self.T_range[1] and \
+                    self.p_range[0] <= p <= self.p_range[1]:
+                return float(self._spline.ev(T, p))
+            return self.func(T, p, x)
+        return self.evaluate(T, p, x)
+
+
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    ALL = 1
+
+    if 0 or ALL:
+        f = lambda T, p, x=0.: 1e3 + 0.5 * T + 1e-6 * T**2 + 1e-5 * p
+        table = PropertyTable(f, (273., 573.), (1e5, 1e7), 'example',
+                              func_vec=f, path='', silent=False)
+        print('value:', table(300., 2e5), 'exact:', f(300., 2e5))
+        print(table)
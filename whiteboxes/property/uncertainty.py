@@ -0,0 +1,392 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+__all__ = ['InputDistribution', 'input_from_parameter', 'property_model',
+           'propagate']
+
+from concurrent.futures import ProcessPoolExecutor, ThreadPoolExecutor
+import numpy as np
+from scipy.special import ndtri
+from typing import Any, Callable, Dict, Iterable, Optional, Tuple, Union
+
+try:
+    from parameter import Parameter
+    from property import Property
+    from range import (Range, is_bound_absolute, is_bound_relative_to_reading,
+        make_rng, percentage_of_bound, relative_to_absolute_range)
+except:
+    from coloredlids.property.parameter import Parameter
+    from coloredlids.property.property import Property
+    from coloredlids.property.range import (Range, is_bound_absolute,
+        is_bound_relative_to_reading, make_rng, percentage_of_bound,
+        relative_to_absolute_range)
+
+
+"""
+    Propagation of input uncertainties y = f(x_1, ..., x_n)
+
+    methods:
+        'linear':    first order Taylor series, var(y) = sum_i (df/dx_i s_i)^2
+                     2n+1 model evaluations (or gradient function)
+        'lhs':       Monte-Carlo with Latin hypercube sampling
+                     n_samples model evaluations
+        'unscented': sigma points x_i = mean_i +/- sqrt(3) s_i
+                     2n+1 model evaluations, exact up to 3rd order
+                     for Gaussian inputs
+
+    All samples are evaluated with a single call of the vectorized model
+    function (or in chunks in parallel), the model must accept arrays
+"""
+
+
+class InputDistribution(object):
+    """
+    Distribution of an uncertain input: value plus random deviation in
+    the absolute error range [lo, up]. The distributions are consistent
+    with Range.simulate():
+
+        'cont', 'flat', 'samp': uniform in [lo, up]
+        'gauss', 'norm', 'bell': normal, mean (lo+up)/2, std |up-lo|/3
+        other: lo + (up - lo) * N(0, 1)
+    """
+
+    def __init__(self, value: float, lo: float = 0., up: float = 0.,
+                 distr: Optional[str] = None) -> None:
+        """
+        Args:
+            value:
+                nominal value (reading)
+            lo:
+                absolute lower bound of deviation
+            up:
+                absolute upper bound of deviation
+            distr:
+                distribution. If None, 'gauss' is used
+        """
+        self.value = float(value)
+        self.lo = float(lo)
+        self.up = float(up)
+        self.distr = (distr or 'gauss').lower()
+
+    def __str__(self) -> str:
+        return f'{self.value} ({self.lo}, {self.up}, {self.distr})'
+
+    @property
+    def _is_uniform(self) -> bool:
+        return self.distr.startswith(('cont', 'flat', 'samp'))
+
+    @property
+    def _is_gauss(self) -> bool:
+        return self.distr.startswith(('gauss', 'norm', 'bell'))
+
+    @property
+    def mean(self) -> float:
+        if self._is_uniform or self._is_gauss:
+            return self.value + 0.5 * (self.lo + self.up)
+        return self.value + self.lo
+
+    @property
+    def std(self) -> float:
+        if self._is_uniform:
+            return abs(self.up - self.lo) / np.sqrt(12.)
+        if self._is_gauss:
+            return abs(self.up - self.lo) / 3.
+        return abs(self.up - self.lo)
+
+    def ppf(self, u: np.ndarray) -> np.ndarray:
+        """
+        Args:
+            u:
+                probabilities in (0, 1)
+
+        Returns:
+            quantiles of distribution (inverse cumulative distribution)
+        """
+        u = np.clip(u, 1e-12, 1. - 1e-12)
+        if self._is_uniform:
+            return self.value + self.lo + (self.up - self.lo) * u
+        return self.mean + self.std * ndtri(u)
+
+
+def input_from_parameter(par: Parameter, range_key: str = 'accuracy',
+                         value: Optional[float] = None) -> InputDistribution:
+    """
+    Converts a parameter and one of its error ranges to an input
+    distribution. Bounds relative to reading ('1%') refer to 'value',
+    bounds relative to full scale ('1%FS') to the span of 'full_scale'
+
+    Args:
+        par:
+            parameter with error range, e.g. 'accuracy' or 'repeatability'
+        range_key:
+            key of error range
+        value:
+            nominal value. If None, par.ref or par.val is used
+
+    Returns:
+        input distribution
+    """
+    if value is None:
+        value = par.ref if par.ref is not None else par.val
+    value = float(np.ravel(value)[0])
+    rng = par[range_key]
+    assert isinstance(rng, Range), str(range_key)
+
+    bounds = []
+    for bound in (rng.lo, rng.up):
+        if bound is None:
+            bounds.append(0.)
+        elif is_bound_absolute(bound):
+            bounds.append(float(bound))
+        elif is_bound_relative_to_reading(bound):
+            bounds.append(percentage_of_bound(bound) * value)
+        else:
+            fs = relative_to_absolute_range(Range(bound, bound),
+                                            par.full_scale)
+            bounds.append(0. if fs is None else float(fs.lo))
+
+    distr = rng.distr if isinstance(rng.distr, str) and \
+        not rng.distr.endswith('%') else None
+    return InputDistribution(value, bounds[0], bounds[1], distr)
+
+
+def property_model(prop: Property) -> Tuple[Callable[..., np.ndarray],
+                                            Callable[..., np.ndarray]]:
+    """
+    Wraps a property as model of inputs T, p and x for propagate()
+
+    Returns:
+        vectorized model function f(T, p, x), see Property.eval_batch()
+        and gradient function, see Property.grad()
+
+    Example:
+        func, grad = property_model(water.rho)
+        res = propagate(func, {'T': water.T, 'p': 1e5, 'x': 0.},
+                        method='linear', gradient=grad)
+    """
+    def func(T, p, x):
+        return prop.eval_batch(T, p, x)[0]
+
+    def gradient(T, p, x):
+        return prop.grad(float(T), float(p), float(x))[1]
+
+    return func, gradient
+
+
+def _evaluate(func: Callable[..., np.ndarray],
+              samples: Dict[str, np.ndarray], n_jobs: int = 1,
+              chunk_size: Optional[int] = None,
+              executor: str = 'thread') -> np.ndarray:
+    """
+    Evaluates vectorized model for all samples, in chunks in parallel
+    if n_jobs > 1. Samples are split along the first axis
+    """
+    n = len(next(iter(samples.values())))
+    if n_jobs <= 1 or n < 2:
+        return np.asfarray(func(**samples))
+
+    if chunk_size is None:
+        chunk_size = int(np.ceil(n / n_jobs))
+    starts = range(0, n, chunk_size)
+    chunks = [{key: val[i:i+chunk_size] for key, val in samples.items()}
+              for i in starts]
+    Executor = ProcessPoolExecutor if executor == 'process' \
+        else ThreadPoolExecutor
+    with Executor(max_workers=n_jobs) as pool:
+        results = list(pool.map(_call, [func] * len(chunks), chunks))
+    return np.concatenate([np.asfarray(r) for r in results], axis=0)
+
+
+def _call(func: Callable[..., np.ndarray],
+          kwargs: Dict[str, np.ndarray]) -> np.ndarray:
+    return func(**kwargs)
+
+
+def propagate(func: Callable[..., np.ndarray],
+              inputs: Dict[str, Union[Parameter, InputDistribution, float]],
+              method: str = 'lhs',
+              n_samples: int = 1000,
+              range_key: str = 'accuracy',
+              confidence: float = 0.95,
+              seed: Optional[int] = None,
+              n_jobs: int = 1,
+              chunk_size: Optional[int] = None,
+              executor: str = 'thread',
+              gradient: Optional[Callable[..., Iterable[float]]] = None
+              ) -> Dict[str, Any]:
+    """
+    Propagates uncertainties of inputs through a vectorized model
+
+    Args:
+        func:
+            vectorized model y = func(**inputs), accepts 1D arrays of
+            equal length and returns array with samples along first axis
+
+        inputs:
+            dictionary of model arguments:
+              - Parameter: uncertainty from range 'range_key'
+              - InputDistribution
+              - float: fixed value without uncertainty
+
+        method:
+            'linear', 'lhs' (Latin hypercube Monte-Carlo) or 'unscented'
+
+        n_samples:
+            number of samples of method 'lhs'
+
+        range_key:
+            key of error range of Parameter inputs, e.g. 'accuracy'
+            or 'repeatability'
+
+        confidence:
+            confidence level of interval [lo, up]
+
+        seed:
+            key of random generator of method 'lhs', see make_rng()
+
+        n_jobs:
+            number of parallel workers for evaluation of samples
+
+        chunk_size:
+            number of samples per worker call. If None, samples are
+            equally distributed to workers
+
+        executor:
+            'thread' or 'process'; processes require picklable 'func'
+
+        gradient:
+            optional gradient function of method 'linear', returns
+            derivatives of y with respect to inputs in order of 'inputs'
+            at the mean values. If None, central differences are used
+
+    Returns:
+        dictionary with keys:
+            'mean', 'std': mean and standard deviation of output
+            'lo', 'up': confidence interval of output
+            'method': propagation method
+            'samples', 'y': input samples and outputs of model ('lhs')
+            'sensitivity': std contribution of inputs ('linear')
+    """
+    assert method in ('linear', 'lhs', 'unscented'), str(method)
+
+    dists: Dict[str, InputDistribution] = {}
+    for key, val in inputs.items():
+        if isinstance(val, InputDistribution):
+            dists[key] = val
+        elif isinstance(val, Parameter):
+            dists[key] = input_from_parameter(val, range_key)
+        else:
+            dists[key] = InputDistribution(val)
+    keys = list(dists.keys())
+    mean = np.array([dists[key].mean for key in keys])
+    std = np.array([dists[key].std for key in keys])
+    n = len(keys)
+    z = float(ndtri(0.5 + 0.5 * confidence))
+    result: Dict[str, Any] = {'method': method}
+
+    if method == 'lhs':
+        rng = make_rng(seed)
+        samples = {}
+        for key in keys:
+            u = (rng.permutation(n_samples) + rng.random(n_samples)) \
+                / n_samples
+            samples[key] = dists[key].ppf(u)
+        y = _evaluate(func, samples, n_jobs, chunk_size, executor)
+        alpha = 0.5 * (1. - confidence)
+        result.update({'mean': np.nanmean(y, axis=0),
+                       'std': np.nanstd(y, axis=0, ddof=1),
+                       'lo': np.nanquantile(y, alpha, axis=0),
+                       'up': np.nanquantile(y, 1. - alpha, axis=0),
+                       'samples': samples, 'y': y})
+        return result
+
+    if method == 'linear' and gradient is not None:
+        y0 = np.asfarray(func(**{key: np.atleast_1d(mean[i])
+                                 for i, key in enumerate(keys)}))[0]
+        grad = np.asfarray(gradient(**{key: mean[i]
+                                       for i, key in enumerate(keys)}))
+        grad = grad.reshape((n,) + np.shape(y0))
+        contribution = np.abs(grad * std.reshape((n,) + (1,) * np.ndim(y0)))
+        y_std = np.sqrt(np.sum(contribution**2, axis=0))
+        result.update({'mean': y0, 'std': y_std, 'lo': y0 - z * y_std,
+                       'up': y0 + z * y_std,
+                       'sensitivity': dict(zip(keys, contribution))})
+        return result
+
+    # points: mean and mean +/- h_i e_i, evaluated in one batch
+    if method == 'linear':
+        h = np.where(std > 0., 1e-3 * std, 1.)
+    else:
+        h = np.sqrt(3.) * std
+    X = np.tile(mean, (2 * n + 1, 1))
+    for i in range(n):
+        X[1 + i, i] += h[i]
+        X[1 + n + i, i] -= h[i]
+    y = _evaluate(func, {key: X[:, i] for i, key in enumerate(keys)},
+                  n_jobs, chunk_size, executor)
+    y0, y_plus, y_minus = y[0], y[1:n+1], y[n+1:]
+
+    if method == 'linear':
+        shape = (n,) + (1,) * np.ndim(y0)
+        grad = (y_plus - y_minus) / (2. * h.reshape(shape))
+        grad = np.where(std.reshape(shape) > 0., grad, 0.)
+        contribution = np.abs(grad * std.reshape(shape))
+        y_mean = y0
+        y_std = np.sqrt(np.sum(contribution**2, axis=0))
+        result['sensitivity'] = dict(zip(keys, contribution))
+    else:
+        # unscented transform with kappa = 3 - n: weights of sigma
+        # points are 1/6, weight of center point is 1 - n/3
+        w0, wi = 1. - n / 3., 1. / 6.
+        y_mean = w0 * y0 + wi * np.sum(y_plus + y_minus, axis=0)
+        var = w0 * (y0 - y_mean)**2 + wi * np.sum((y_plus - y_mean)**2 +
+                                                 (y_minus - y_mean)**2,
+                                                 axis=0)
+        y_std = np.sqrt(np.maximum(var, 0.))
+
+    result.update({'mean': y_mean, 'std': y_std, 'lo': y_mean - z * y_std,
+                   'up': y_mean + z * y_std})
+    return result
+
+
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    ALL = 1
+
+    if 0 or ALL:
+        from coloredlids.flow.pressure_drop import dp_in_red_mid_exp_out
+
+        def model(v1, D1, nu):
+            return dp_in_red_mid_exp_out(v1, D1, 1., 0.5 * D1, 1., D1, 1.,
+                                         nu=nu)[0]
+
+        inputs = {'v1': InputDistribution(2., -0.1, 0.1, 'cont'),
+                  'D1': InputDistribution(50e-3, -0.2e-3, 0.2e-3),
+                  'nu': InputDistribution(1e-6, -0.05e-6, 0.05e-6)}
+        for method in ('linear', 'lhs', 'unscented'):
+            res = propagate(model, inputs, method=method, n_samples=10000,
+                            seed=42)
+            print(f"{method:>10}: dp = {res['mean']:.1f} +/- "
+                  f"{res['std']:.1f} Pa, 95%: [{res['lo']:.1f}, "
+                  f"{res['up']:.1f}]")
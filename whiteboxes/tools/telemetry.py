@@ -0,0 +1,262 @@
+"""
+  Copyright (c) 2016- by Dietmar W Weiss
+
+  This is free software; you can redistribute it and/or modify it
+  under the terms of the GNU Lesser General Public License as
+  published by the Free Software Foundation; either version 3.0 of
+  the License, or (at your option) any later version.
+
+  This software is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+  Lesser General Public License for more details.
+
+  You should have received a copy of the GNU Lesser General Public
+  License along with this software; if not, write to the Free
+  Software Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA
+  02110-1301 USA, or see the FSF site: http://www.fsf.org.
+
+  Version:
+      2023-12-04 DWW
+"""
+
+__all__ = ['Telemetry', 'count', 'event', 'iteration']
+
+import csv
+import json
+import sys
+import threading
+from time import perf_counter
+import tracemalloc
+from typing import Any, Dict, List, Optional
+
+# recording Telemetry instance, None if telemetry is disabled
+ACTIVE: Optional['Telemetry'] = None
+
+# counters reported as differences since previous record of solver
+COUNTERS = ('property', 'coolprop', 'memo_hit', 'memo_miss')
+
+
+class Telemetry(object):
+    """
+    Recorder of convergence and cost of iterative solvers
+
+    Solvers emit one record per iteration (residual) and one record at
+    exit (reason of stop), see iteration() and event(). Property
+    evaluations, CoolProp calls and hits and misses of memoized 
+    properties (Property.memoize) are counted by count(). Each record
+    contains the wall time and the numbers of property evaluations,
+    CoolProp calls and allocated memory blocks since the previous
+    record of the same solver
+
+    - telemetry is disabled unless a Telemetry is active; then the
+      module functions return after a single test of ACTIVE
+    - recording is thread-safe, worker processes are not recorded
+
+    Example:
+        with Telemetry() as tel:
+            poisson_bc1_bc1_nonlin_fvm1(n_vol=1000, method='newton')
+        print(tel.summary())
+        tel.to_csv('telemetry.csv')
+    """
+
+    def __init__(self, track_memory: bool = False) -> None:
+        """
+        Args:
+            track_memory:
+                if True, then current and peak memory traced by
+                tracemalloc are recorded; this slows down execution
+        """
+        self.track_memory = track_memory
+        self.records: List[Dict[str, Any]] = []
+        self.counters: Dict[str, int] = {key: 0 for key in COUNTERS}
+        self._lock = threading.Lock()
+        self._start = perf_counter()
+        self._last: Dict[str, Dict[str, float]] = {}
+        self._previous: Optional['Telemetry'] = None
+        self._blocks0 = sys.getallocatedblocks()
+
+    def start(self) -> 'Telemetry':
+        """
+        Activates recording, an active Telemetry is restored by stop()
+
+        Returns:
+            self
+        """
+        global ACTIVE
+        self._previous, ACTIVE = ACTIVE, self
+        self._start = perf_counter()
+        self._blocks0 = sys.getallocatedblocks()
+        if self.track_memory and not tracemalloc.is_tracing():
+            tracemalloc.start()
+        return self
+
+    def stop(self) -> None:
+        """
+        Deactivates recording
+        """
+        global ACTIVE
+        if self.track_memory and tracemalloc.is_tracing():
+            tracemalloc.stop()
+        ACTIVE, self._previous = self._previous, None
+
+    def __enter__(self) -> 'Telemetry':
+        return self.start()
+
+    def __exit__(self, *args: Any) -> None:
+        self.stop()
+
+    def count(self, key: str, n: int = 1) -> None:
+        """
+        Increments counter 'key' by 'n'
+        """
+        with self._lock:
+            self.counters[key] = self.counters.get(key, 0) + n
+
+    def record(self, solver: str, event: str, it: Optional[int] = None,
+               residual: Optional[float] = None, **extra: Any) -> None:
+        """
+        Appends record of 'solver'
+
+        Args:
+            solver:
+                identifier of solver, e.g. function name
+
+            event:
+                'iteration' or reason of exit, e.g. 'converged', 'max_it'
+
+            it:
+                index of iteration or time step
+
+            residual:
+                residual or other measure of convergence
+
+            extra:
+                additional solver-specific values
+        """
+        now = perf_counter()
+        blocks = sys.getallocatedblocks()
+        with self._lock:
+            last = self._last.get(solver)
+            if last is None:
+                last = dict(self.counters, time=self._start,
+                            blocks=self._blocks0)
+            row: Dict[str, Any] = {
+                'solver': solver,
+                'event': event,
+                'it': it,
+                'residual': None if residual is None else float(residual),
+                'time': now - self._start,
+                'dt': now - last['time'],
+                'n_alloc': blocks - last['blocks']}
+            for key, value in self.counters.items():
+                row['n_' + key] = value - last.get(key, 0)
+            if self.track_memory and tracemalloc.is_tracing():
+                row['mem_current'], row['mem_peak'] = \
+                    tracemalloc.get_traced_memory()
+            row.update(extra)
+            self.records.append(row)
+            self._last[solver] = dict(self.counters, time=now,
+                                      blocks=blocks)
+
+    def summary(self) -> Dict[str, Dict[str, Any]]:
+        """
+        Returns:
+            totals per solver: number of records, wall time, counters
+            and last residual and exit reason
+        """
+        result: Dict[str, Dict[str, Any]] = {}
+        for row in self.records:
+            s = result.setdefault(row['solver'], {'n_iterations': 0,
+                'n_exits': 0, 'time': 0., 'residual': None, 'exit': None})
+            if row['event'] == 'iteration':
+                s['n_iterations'] += 1
+            else:
+                s['n_exits'] += 1
+                s['exit'] = row['event']
+            s['time'] += row['dt']
+            if row['residual'] is not None:
+                s['residual'] = row['residual']
+            for key in ['n_alloc'] + ['n_' + c for c in self.counters]:
+                s[key] = s.get(key, 0) + row.get(key, 0)
+        return result
+
+    def fields(self) -> List[str]:
+        """
+        Returns:
+            union of keys of all records in order of first appearance
+        """
+        keys: Dict[str, None] = {}
+        for row in self.records:
+            keys.update(dict.fromkeys(row))
+        return list(keys)
+
+    def to_json(self, file: str) -> None:
+        """
+        Writes counters, summary and records to JSON file
+        """
+        with open(file, 'w') as f:
+            json.dump({'counters': self.counters, 'summary': self.summary(),
+                       'records': self.records}, f, indent=1, default=float)
+
+    def to_csv(self, file: str) -> None:
+        """
+        Writes records to CSV file, one row per record
+        """
+        with open(file, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=self.fields())
+            writer.writeheader()
+            writer.writerows(self.records)
+
+    def clear(self) -> None:
+        """
+        Removes all records and resets counters
+        """
+        with self._lock:
+            self.records.clear()
+            self._last.clear()
+            self.counters = {key: 0 for key in COUNTERS}
+
+
+def count(key: str, n: int = 1) -> None:
+    """
+    Increments counter of active Telemetry, e.g. count('coolprop')
+    """
+    if ACTIVE is not None:
+        ACTIVE.count(key, n)
+
+
+def iteration(solver: str, it: int, residual: Optional[float] = None,
+              **extra: Any) -> None:
+    """
+    Records iteration of solver in active Telemetry
+    """
+    if ACTIVE is not None:
+        ACTIVE.record(solver, 'iteration', it, residual, **extra)
+
+
+def event(solver: str, event: str, it: Optional[int] = None,
+          residual: Optional[float] = None, **extra: Any) -> None:
+    """
+    Records exit of solver with reason 'event' in active Telemetry,
+    e.g. 'converged', 'max_it' or 't_max'
+    """
+    if ACTIVE is not None:
+        ACTIVE.record(solver, event, it, residual, **extra)
+
+
+# Examples ####################################################################
+
+
+if __name__ == '__main__':
+    ALL = 1
+
+    if 0 or ALL:
+        with Telemetry() as tel:
+            residual = 1.
+            for it in range(5):
+                count('property', 10)
+                residual *= 0.1
+                iteration('example', it, residual)
+            event('example', 'converged', it, residual)
+        print(tel.summary())